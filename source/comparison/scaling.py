@@ -0,0 +1,353 @@
+import argparse
+import json
+import os
+import subprocess
+import tempfile
+import time
+
+import matplotlib.pyplot as plt
+
+# Scaling benchmark: time-to-target of each solver versus set size, thread
+# count and NUMA socket count, on planted sets generated by
+# subset_sum_generator.
+#
+# Planted sets have a known optimum (loss 0), so time-to-target is the
+# elapsed time of the first telemetry sample reaching loss 0. Runs that
+# never reach it report their total time and "reached": false.
+
+path_to_executables = "./../../build/bin"
+
+# Extra arguments and the largest n each solver is run on. The exact
+# solvers are exponential and get their own, much smaller sizes.
+heuristic_solvers = {
+    "subset_sum_hill_climbing": {"args": [], "max_n": 10**5},
+    "subset_sum_sim_annealing": {"args": ["linear"], "max_n": 10**6},
+    "subset_sum_tabu_search": {"args": ["50"], "max_n": 10**4},
+    "subset_sum_genetic_algorithm": {
+        "args": ["100", "two_point", "single_bit_flip", "fitness_threshold"],
+        "max_n": 10**5,
+    },
+    "subset_sum_genetic_algorithm_parallel": {
+        "args": ["100", "two_point", "single_bit_flip", "fitness_threshold"],
+        "max_n": 10**5,
+    },
+}
+
+exact_solvers = {
+    "subset_sum_full_search": {"args": [], "sizes": [16, 20, 24, 28]},
+    "subset_sum_branch_and_bound": {"args": [], "sizes": [32, 64, 128, 256]},
+}
+
+# Solvers taking --threads, with the set size used to compare thread and
+# socket counts.
+threaded_solvers = {
+    "subset_sum_full_search": {"args": [], "n": 28},
+    "subset_sum_branch_and_bound": {"args": [], "n": 256},
+    "subset_sum_genetic_algorithm_parallel": {
+        "args": ["300", "two_point", "single_bit_flip", "fitness_threshold"],
+        "n": 10**4,
+    },
+}
+
+
+def generate_set(directory: str, count: int, seed: int, max_value: int) -> tuple:
+    path = os.path.join(directory, f"planted_{count}_{seed}.bin")
+    result = subprocess.run(
+        [
+            f"{path_to_executables}/subset_sum_generator",
+            path,
+            str(count),
+            "planted",
+            f"--seed={seed}",
+            "--format=binary",
+            f"--max-value={max_value}",
+            f"--planted-size={min(count // 2, 32)}",
+        ],
+        capture_output=True,
+        text=True,
+        check=True,
+    )
+
+    return path, json.loads(result.stdout)["target"]
+
+
+def time_to_target(
+    algorithm: str,
+    set_path: str,
+    target: int,
+    args: list,
+    timeout: float,
+    prefix: list = [],
+) -> dict:
+    with tempfile.NamedTemporaryFile(suffix=".ndjson") as telemetry:
+        command = [
+            *prefix,
+            f"{path_to_executables}/{algorithm}",
+            set_path,
+            str(target),
+            *args,
+            f"--telemetry={telemetry.name}",
+            "--telemetry-interval=10",
+        ]
+
+        start = time.perf_counter()
+        try:
+            result = subprocess.run(
+                command, capture_output=True, text=True, timeout=timeout
+            )
+        except subprocess.TimeoutExpired:
+            return {"time_ms": timeout * 1000, "reached": False, "timeout": True}
+        wall_ms = (time.perf_counter() - start) * 1000
+
+        if result.returncode != 0:
+            raise RuntimeError(
+                f"Error running {command}: {result.stderr} {result.stdout}"
+            )
+
+        with open(telemetry.name) as samples:
+            for line in samples:
+                sample = json.loads(line)
+                if sample.get("best_loss") == 0:
+                    return {"time_ms": sample["elapsed_ms"], "reached": True}
+
+    return {
+        "time_ms": json.loads(result.stdout).get("time_ms", wall_ms),
+        "reached": False,
+    }
+
+
+def run_size_scaling(
+    directory: str, sizes: list, seeds: int, timeout: float
+) -> dict:
+    results = {}
+
+    for algorithm, config in heuristic_solvers.items():
+        results[algorithm] = []
+        for count in sizes:
+            if count > config["max_n"]:
+                continue
+            for seed in range(seeds):
+                set_path, target = generate_set(directory, count, seed, 10**6)
+                print(f"{algorithm} n={count} seed={seed}")
+                run = time_to_target(
+                    algorithm, set_path, target, config["args"], timeout
+                )
+                results[algorithm].append({"n": count, "seed": seed, **run})
+
+    for algorithm, config in exact_solvers.items():
+        results[algorithm] = []
+        for count in config["sizes"]:
+            for seed in range(seeds):
+                set_path, target = generate_set(directory, count, seed, 10**6)
+                print(f"{algorithm} n={count} seed={seed}")
+                run = time_to_target(
+                    algorithm, set_path, target, config["args"], timeout
+                )
+                results[algorithm].append({"n": count, "seed": seed, **run})
+
+    return results
+
+
+def run_thread_scaling(
+    directory: str, thread_counts: list, seeds: int, timeout: float
+) -> dict:
+    results = {}
+
+    for algorithm, config in threaded_solvers.items():
+        results[algorithm] = []
+        count = config["n"]
+        for seed in range(seeds):
+            set_path, target = generate_set(directory, count, seed, 10**6)
+            for threads in thread_counts:
+                print(f"{algorithm} n={count} threads={threads} seed={seed}")
+                run = time_to_target(
+                    algorithm,
+                    set_path,
+                    target,
+                    config["args"] + [f"--threads={threads}"],
+                    timeout,
+                )
+                results[algorithm].append(
+                    {"n": count, "threads": threads, "seed": seed, **run}
+                )
+
+    return results
+
+
+def numa_nodes() -> list:
+    """CPU lists of the NUMA nodes, in node order."""
+    nodes = []
+    base = "/sys/devices/system/node"
+    if not os.path.isdir(base):
+        return nodes
+
+    names = [
+        n for n in os.listdir(base) if n.startswith("node") and n[4:].isdigit()
+    ]
+    for name in sorted(names, key=lambda n: int(n[4:])):
+        with open(f"{base}/{name}/cpulist") as cpulist:
+            cpus = cpulist.read().strip()
+        if cpus:
+            nodes.append(cpus)
+
+    return nodes
+
+
+def count_cpus(cpu_list: str) -> int:
+    count = 0
+    for part in cpu_list.split(","):
+        first, _, last = part.partition("-")
+        count += int(last or first) - int(first) + 1
+    return count
+
+
+def run_socket_scaling(directory: str, seeds: int, timeout: float) -> dict:
+    """Runs the threaded solvers on the first 1, 2, ... NUMA nodes, using
+    every CPU of those nodes. The pools pin their workers to the CPUs the
+    process is allowed to use, so taskset is all it takes."""
+    results = {}
+    nodes = numa_nodes()
+
+    for algorithm, config in threaded_solvers.items():
+        results[algorithm] = []
+        count = config["n"]
+        for seed in range(seeds):
+            set_path, target = generate_set(directory, count, seed, 10**6)
+            for sockets in range(1, len(nodes) + 1):
+                cpus = ",".join(nodes[:sockets])
+                threads = count_cpus(cpus)
+                print(f"{algorithm} n={count} sockets={sockets} seed={seed}")
+                run = time_to_target(
+                    algorithm,
+                    set_path,
+                    target,
+                    config["args"] + [f"--threads={threads}"],
+                    timeout,
+                    prefix=["taskset", "-c", cpus],
+                )
+                results[algorithm].append(
+                    {
+                        "n": count,
+                        "sockets": sockets,
+                        "threads": threads,
+                        "seed": seed,
+                        **run,
+                    }
+                )
+
+    return results
+
+
+def median_by(runs: list, key: str) -> tuple:
+    values = {}
+    for run in runs:
+        values.setdefault(run[key], []).append(run["time_ms"])
+
+    xs = sorted(values)
+    ys = [sorted(values[x])[len(values[x]) // 2] for x in xs]
+    return xs, ys
+
+
+def plot(size_results: dict, thread_results: dict, socket_results: dict):
+    plt.figure(figsize=(10, 6))
+    for algorithm, runs in size_results.items():
+        if runs:
+            plt.plot(*median_by(runs, "n"), marker="o", label=algorithm)
+    plt.xscale("log")
+    plt.yscale("log")
+    plt.title("Time to target vs set size (median over seeds)")
+    plt.xlabel("n")
+    plt.ylabel("Time to target (ms)")
+    plt.legend()
+    plt.grid()
+    plt.show()
+
+    plt.figure(figsize=(10, 6))
+    for algorithm, runs in thread_results.items():
+        threads, times = median_by(runs, "threads")
+        plt.plot(
+            threads,
+            [times[0] / t for t in times],
+            marker="o",
+            label=f"{algorithm} (n={runs[0]['n']})",
+        )
+    plt.title("Speedup vs thread count (median over seeds)")
+    plt.xlabel("Threads")
+    plt.ylabel("Speedup")
+    plt.legend()
+    plt.grid()
+    plt.show()
+
+    if any(socket_results.values()):
+        plt.figure(figsize=(10, 6))
+        for algorithm, runs in socket_results.items():
+            sockets, times = median_by(runs, "sockets")
+            plt.plot(
+                sockets,
+                [times[0] / t for t in times],
+                marker="o",
+                label=f"{algorithm} (n={runs[0]['n']})",
+            )
+        plt.title("Speedup vs socket count, all cores of each socket")
+        plt.xlabel("Sockets")
+        plt.ylabel("Speedup over one socket")
+        plt.legend()
+        plt.grid()
+        plt.show()
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Time-to-target of each solver versus n and thread count"
+    )
+    parser.add_argument("--max-n", type=int, default=10**5)
+    parser.add_argument("--seeds", type=int, default=3)
+    parser.add_argument("--timeout", type=float, default=60.0)
+    parser.add_argument("--output", default="scaling.json")
+    parser.add_argument("--no-plot", action="store_true")
+    parser.add_argument("--no-sockets", action="store_true")
+    args = parser.parse_args()
+
+    sizes = []
+    count = 10**3
+    while count <= args.max_n:
+        sizes.append(count)
+        count *= 10
+
+    cpu_count = os.cpu_count() or 1
+    thread_counts = [1]
+    while thread_counts[-1] * 2 <= cpu_count:
+        thread_counts.append(thread_counts[-1] * 2)
+    if thread_counts[-1] != cpu_count:
+        thread_counts.append(cpu_count)
+
+    with tempfile.TemporaryDirectory() as directory:
+        size_results = run_size_scaling(
+            directory, sizes, args.seeds, args.timeout
+        )
+        thread_results = run_thread_scaling(
+            directory, thread_counts, args.seeds, args.timeout
+        )
+        socket_results = (
+            {}
+            if args.no_sockets
+            else run_socket_scaling(directory, args.seeds, args.timeout)
+        )
+
+    with open(args.output, "w") as output:
+        json.dump(
+            {
+                "size": size_results,
+                "threads": thread_results,
+                "sockets": socket_results,
+            },
+            output,
+            indent=2,
+        )
+
+    if not args.no_plot:
+        plot(size_results, thread_results, socket_results)
+
+
+if __name__ == "__main__":
+    main()
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <optional>
 #include <print>
+#include <random>
 #include <string_view>
 #include <tuple>
 #include <vector>
@@ -76,7 +78,29 @@ std::tuple<Args...> parse_args(int argc,
   return result;
 }
 
+/// \brief Removes a `--name=value` (or bare `--name`) option from the command
+/// line arguments and returns its value, so that the remaining positional
+/// arguments can be handed to parse_args.
+std::optional<std::string> take_option(int& argc,
+                                       char* argv[],
+                                       std::string_view name);
+
+/// \brief Takes the `--threads=N` option, defaulting to the number of hardware
+/// threads.
+size_t take_thread_count(int& argc, char* argv[]);
+
 std::vector<std::string> read_file(const std::filesystem::path& file_path);
 
+/// \brief Random engine behind the random helpers. Every thread draws from
+/// its own engine.
+std::mt19937& random_engine();
+
+/// \brief Serializes the state of this thread's random engine, so a run can
+/// later continue with exactly the same random sequence.
+std::string save_random_state();
+void load_random_state(const std::string& state);
+
 int get_random_int(int min, int max);
 double get_random_double(double min, double max);
+/// \brief 64 uniformly random bits.
+uint64_t get_random_bits();
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+/// \brief Bounded lock-free single-producer single-consumer queue.
+///
+/// One thread pushes and one thread pops, neither ever blocks: a push to a
+/// full buffer fails and a pop from an empty buffer returns std::nullopt.
+/// Pushes from several threads are fine as long as they are serialized
+/// (e.g. by a mutex), the same holds for pops.
+template <typename T>
+class RingBuffer {
+ public:
+  /// \brief The capacity is rounded up to a power of two.
+  explicit RingBuffer(size_t capacity)
+      : mask_(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1),
+        slots_(std::make_unique<T[]>(mask_ + 1)) {}
+
+  RingBuffer(const RingBuffer&) = delete;
+  RingBuffer& operator=(const RingBuffer&) = delete;
+
+  bool try_push(const T& value) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cached_head_ > mask_) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      if (tail - cached_head_ > mask_) {
+        return false;
+      }
+    }
+
+    slots_[tail & mask_] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  std::optional<T> try_pop() {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == cached_tail_) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head == cached_tail_) {
+        return std::nullopt;
+      }
+    }
+
+    T value = slots_[head & mask_];
+    head_.store(head + 1, std::memory_order_release);
+    return value;
+  }
+
+  size_t capacity() const { return mask_ + 1; }
+
+ private:
+  static constexpr size_t CACHE_LINE = 64;
+
+  const size_t mask_;
+  std::unique_ptr<T[]> slots_;
+
+  // The producer and consumer indices live on separate cache lines, each
+  // next to the side's cached copy of the other index, so the two threads
+  // only share a line when the cached copy runs out.
+  alignas(CACHE_LINE) std::atomic<size_t> tail_{0};
+  size_t cached_head_ = 0;
+  alignas(CACHE_LINE) std::atomic<size_t> head_{0};
+  size_t cached_tail_ = 0;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// \brief Fixed-size work-stealing thread pool.
+///
+/// Every worker owns a task deque. Workers pop their own tasks from the back
+/// (newest first, good locality for tasks that spawn subtasks) and steal from
+/// the front of the other deques when they run dry.
+///
+/// Workers are pinned to the allowed CPUs round-robin across NUMA nodes,
+/// so a small pool gets the memory bandwidth of every node, and memory a
+/// worker allocates and touches first stays on its node. Pools created
+/// from inside a task (e.g. a solver run by the server) are not pinned,
+/// their workers may run on any allowed CPU.
+class ThreadPool {
+ public:
+  explicit ThreadPool(
+      size_t thread_count = std::thread::hardware_concurrency());
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// \brief Queues a task. Tasks submitted from a worker go to its own deque.
+  void submit(std::function<void()> task);
+
+  /// \brief Queues a task on the deque of a given worker. An idle worker may
+  /// still steal it.
+  void submit_to(size_t worker, std::function<void()> task);
+
+  /// \brief Blocks until every submitted task (and its subtasks) finished.
+  /// Must not be called from inside a task.
+  void wait();
+
+  size_t size() const { return workers_.size(); }
+
+  /// \brief NUMA node the worker runs on, 0 if it is not pinned.
+  int worker_node(size_t worker) const { return workers_[worker]->node; }
+
+  /// \brief Items per chunk when splitting `item_count` items of
+  /// `item_bytes` each: small enough for a chunk to fit in L2, and at least
+  /// one chunk per worker.
+  size_t chunk_size(size_t item_count, size_t item_bytes) const;
+
+ private:
+  struct Worker {
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    int cpu = -1;
+    int node = 0;
+  };
+
+  void push(size_t index, std::function<void()> task);
+  void run(size_t index);
+  bool pop_task(size_t index, std::function<void()>& task);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+
+  std::mutex state_mutex_;
+  std::condition_variable task_available_;
+  std::condition_variable all_done_;
+
+  std::atomic<size_t> queued_{0};
+  std::atomic<size_t> pending_{0};
+  std::atomic<size_t> next_worker_{0};
+  bool stopping_ = false;
+};
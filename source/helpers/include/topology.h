@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/// \brief The CPUs this process may run on, grouped by NUMA node, and the
+/// L2 cache size. Read once from the OS; on platforms without topology
+/// information every CPU is on node 0.
+///
+/// The CPU set respects the process affinity, so running under
+/// `taskset`/`numactl` restricts the thread pools to those CPUs. It is read
+/// on the first call, which the first thread pool makes before pinning any
+/// thread, so it is the affinity the process started with.
+struct CpuTopology {
+  /// Allowed CPUs, all CPUs of node 0 first, then node 1, ...
+  std::vector<int> cpus;
+  /// NUMA node of each entry of `cpus`.
+  std::vector<int> cpu_nodes;
+  /// Number of distinct nodes in `cpu_nodes`.
+  size_t node_count = 1;
+  /// L2 cache size in bytes, per core.
+  size_t l2_cache_size = 1 << 20;
+};
+
+const CpuTopology& cpu_topology();
+
+/// \brief Pins the calling thread to one CPU. Returns false if pinning is
+/// not supported or failed, the thread then keeps running unpinned.
+bool pin_current_thread(int cpu);
+
+/// \brief Lets the calling thread run on every allowed CPU again, undoing
+/// the pinning it inherited from the thread that created it.
+bool unpin_current_thread();
@@ -1,7 +1,10 @@
 #include "helpers.h"
 
+#include <algorithm>
 #include <fstream>
-#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
 
 std::vector<std::string> read_file(const std::filesystem::path& file_path) {
   std::vector<std::string> lines;
@@ -19,18 +22,83 @@ std::vector<std::string> read_file(const std::filesystem::path& file_path) {
   return lines;
 }
 
+std::optional<std::string> take_option(int& argc,
+                                       char* argv[],
+                                       std::string_view name) {
+  std::optional<std::string> value;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    if (!arg.starts_with("--") || !arg.substr(2).starts_with(name)) {
+      continue;
+    }
+
+    auto rest = arg.substr(2 + name.size());
+    if (rest.empty()) {
+      value = "";
+    } else if (rest.front() == '=') {
+      value = std::string(rest.substr(1));
+    } else {
+      continue;
+    }
+
+    // Shift the remaining arguments left over the consumed option.
+    for (int j = i; j + 1 < argc; ++j) {
+      argv[j] = argv[j + 1];
+    }
+    --argc;
+    --i;
+  }
+
+  return value;
+}
+
+size_t take_thread_count(int& argc, char* argv[]) {
+  auto threads = take_option(argc, argv, "threads");
+  if (threads.has_value() && !threads->empty()) {
+    return std::max(convert_type<int>(*threads), 1);
+  }
+
+  return std::max(std::thread::hardware_concurrency(), 1U);
+}
+
+std::mt19937& random_engine() {
+  static thread_local std::random_device rd;
+  static thread_local std::mt19937 gen(rd());
+
+  return gen;
+}
+
+std::string save_random_state() {
+  std::ostringstream out;
+  out << random_engine();
+
+  return out.str();
+}
+
+void load_random_state(const std::string& state) {
+  std::istringstream in(state);
+  in >> random_engine();
+
+  if (in.fail()) {
+    throw std::invalid_argument("Invalid random engine state");
+  }
+}
+
 int get_random_int(int min, int max) {
-  static std::random_device rd;
-  static std::mt19937 gen(rd());
   std::uniform_int_distribution<> dis(min, max);
 
-  return dis(gen);
+  return dis(random_engine());
 }
 
 double get_random_double(double min, double max) {
-  static std::random_device rd;
-  static std::mt19937 gen(rd());
   std::uniform_real_distribution<> dis(min, max);
 
-  return dis(gen);
+  return dis(random_engine());
+}
+
+uint64_t get_random_bits() {
+  auto& engine = random_engine();
+  uint64_t high = engine();
+  return (high << 32) | engine();
 }
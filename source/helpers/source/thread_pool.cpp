@@ -0,0 +1,169 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+#include "topology.h"
+
+namespace {
+
+// Pool and worker index of the current thread, if it is a pool worker.
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_worker = 0;
+
+/// Indices into `topology.cpus` in the order workers are placed: the first
+/// CPU of every node, then the second CPU of every node, and so on.
+std::vector<size_t> spread_across_nodes(const CpuTopology& topology) {
+  std::vector<std::vector<size_t>> by_node;
+  for (size_t slot = 0; slot < topology.cpus.size(); ++slot) {
+    if (slot == 0 ||
+        topology.cpu_nodes[slot] != topology.cpu_nodes[slot - 1]) {
+      by_node.emplace_back();
+    }
+    by_node.back().push_back(slot);
+  }
+
+  std::vector<size_t> order;
+  for (size_t rank = 0; order.size() < topology.cpus.size(); ++rank) {
+    for (const auto& node : by_node) {
+      if (rank < node.size()) {
+        order.push_back(node[rank]);
+      }
+    }
+  }
+  return order;
+}
+
+}  // namespace
+
+ThreadPool::ThreadPool(size_t thread_count) {
+  thread_count = std::max<size_t>(thread_count, 1);
+
+  // Threads inherit the affinity of the thread creating them. Nested pools
+  // are not pinned, their workers undo the pinning of the outer worker.
+  bool pin = current_pool == nullptr;
+  const auto& topology = cpu_topology();
+  auto order = spread_across_nodes(topology);
+
+  for (size_t i = 0; i < thread_count; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+    if (pin) {
+      size_t slot = order[i % order.size()];
+      workers_[i]->cpu = topology.cpus[slot];
+      workers_[i]->node = topology.cpu_nodes[slot];
+    }
+  }
+
+  for (size_t i = 0; i < thread_count; ++i) {
+    threads_.emplace_back([this, i] { run(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  wait();
+
+  {
+    std::lock_guard lock(state_mutex_);
+    stopping_ = true;
+  }
+  task_available_.notify_all();
+
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+  size_t index = current_pool == this
+                     ? current_worker
+                     : next_worker_.fetch_add(1) % workers_.size();
+  push(index, std::move(task));
+}
+
+void ThreadPool::submit_to(size_t worker, std::function<void()> task) {
+  push(worker % workers_.size(), std::move(task));
+}
+
+size_t ThreadPool::chunk_size(size_t item_count, size_t item_bytes) const {
+  size_t per_worker = (item_count + workers_.size() - 1) / workers_.size();
+  size_t fits_l2 =
+      cpu_topology().l2_cache_size / std::max<size_t>(item_bytes, 1);
+  return std::max<size_t>(std::min(per_worker, fits_l2), 1);
+}
+
+void ThreadPool::push(size_t index, std::function<void()> task) {
+  pending_.fetch_add(1);
+  {
+    // Counting the task under the lock orders it with a worker going to
+    // sleep, so the notification below cannot be missed.
+    std::lock_guard lock(state_mutex_);
+    queued_.fetch_add(1);
+  }
+
+  {
+    std::lock_guard lock(workers_[index]->mutex);
+    workers_[index]->tasks.push_back(std::move(task));
+  }
+  task_available_.notify_one();
+}
+
+void ThreadPool::wait() {
+  std::unique_lock lock(state_mutex_);
+  all_done_.wait(lock, [this] { return pending_.load() == 0; });
+}
+
+bool ThreadPool::pop_task(size_t index, std::function<void()>& task) {
+  {
+    auto& own = *workers_[index];
+    std::lock_guard lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      return true;
+    }
+  }
+
+  for (size_t offset = 1; offset < workers_.size(); ++offset) {
+    auto& victim = *workers_[(index + offset) % workers_.size()];
+    std::lock_guard lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void ThreadPool::run(size_t index) {
+  current_pool = this;
+  current_worker = index;
+
+  if (workers_[index]->cpu >= 0) {
+    pin_current_thread(workers_[index]->cpu);
+  } else {
+    unpin_current_thread();
+  }
+
+  while (true) {
+    std::function<void()> task;
+
+    if (pop_task(index, task)) {
+      queued_.fetch_sub(1);
+      task();
+
+      if (pending_.fetch_sub(1) == 1) {
+        std::lock_guard lock(state_mutex_);
+        all_done_.notify_all();
+      }
+      continue;
+    }
+
+    std::unique_lock lock(state_mutex_);
+    task_available_.wait(lock,
+                         [this] { return stopping_ || queued_.load() > 0; });
+    if (stopping_ && queued_.load() == 0) {
+      return;
+    }
+  }
+}
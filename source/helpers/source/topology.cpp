@@ -0,0 +1,178 @@
+#include "topology.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace {
+
+/// Parses a sysfs CPU list such as "0-3,8-11".
+std::vector<int> parse_cpu_list(const std::string& list) {
+  std::vector<int> cpus;
+
+  size_t start = 0;
+  while (start < list.size()) {
+    size_t end = list.find(',', start);
+    if (end == std::string::npos) {
+      end = list.size();
+    }
+
+    auto range = list.substr(start, end - start);
+    auto dash = range.find('-');
+    try {
+      int first = std::stoi(range.substr(0, dash));
+      int last =
+          dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+      for (int cpu = first; cpu <= last; ++cpu) {
+        cpus.push_back(cpu);
+      }
+    } catch (const std::exception&) {
+      // Ignore malformed entries.
+    }
+
+    start = end + 1;
+  }
+
+  return cpus;
+}
+
+std::string read_line(const std::string& path) {
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+/// Parses a sysfs cache size such as "2048K".
+size_t parse_cache_size(const std::string& size) {
+  try {
+    size_t pos = 0;
+    size_t value = std::stoul(size, &pos);
+    if (pos < size.size() && size[pos] == 'K') {
+      value <<= 10;
+    } else if (pos < size.size() && size[pos] == 'M') {
+      value <<= 20;
+    }
+    return value;
+  } catch (const std::exception&) {
+    return 0;
+  }
+}
+
+CpuTopology detect_topology() {
+  CpuTopology topology;
+
+#ifdef __linux__
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  bool have_affinity = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+  auto is_allowed = [&](int cpu) {
+    return !have_affinity || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed));
+  };
+
+  std::vector<int> node_ids;
+  std::error_code error;
+  for (const auto& entry : std::filesystem::directory_iterator(
+           "/sys/devices/system/node", error)) {
+    auto name = entry.path().filename().string();
+    if (name.starts_with("node") && name.size() > 4 &&
+        std::all_of(name.begin() + 4, name.end(),
+                    [](unsigned char c) { return std::isdigit(c); })) {
+      node_ids.push_back(std::stoi(name.substr(4)));
+    }
+  }
+  std::ranges::sort(node_ids);
+
+  size_t used_nodes = 0;
+  for (int node : node_ids) {
+    auto cpulist = read_line("/sys/devices/system/node/node" +
+                             std::to_string(node) + "/cpulist");
+
+    bool used = false;
+    for (int cpu : parse_cpu_list(cpulist)) {
+      if (is_allowed(cpu)) {
+        topology.cpus.push_back(cpu);
+        topology.cpu_nodes.push_back(node);
+        used = true;
+      }
+    }
+    used_nodes += used;
+  }
+
+  if (topology.cpus.empty() && have_affinity) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &allowed)) {
+        topology.cpus.push_back(cpu);
+        topology.cpu_nodes.push_back(0);
+      }
+    }
+  }
+  topology.node_count = std::max<size_t>(used_nodes, 1);
+
+  for (int index = 0; index < 8; ++index) {
+    auto base = "/sys/devices/system/cpu/cpu" +
+                std::to_string(topology.cpus.empty() ? 0 : topology.cpus[0]) +
+                "/cache/index" + std::to_string(index);
+    if (read_line(base + "/level") == "2") {
+      if (size_t size = parse_cache_size(read_line(base + "/size"))) {
+        topology.l2_cache_size = size;
+      }
+      break;
+    }
+  }
+#endif
+
+  if (topology.cpus.empty()) {
+    for (unsigned cpu = 0;
+         cpu < std::max(std::thread::hardware_concurrency(), 1U); ++cpu) {
+      topology.cpus.push_back(static_cast<int>(cpu));
+      topology.cpu_nodes.push_back(0);
+    }
+  }
+
+  return topology;
+}
+
+}  // namespace
+
+const CpuTopology& cpu_topology() {
+  static const CpuTopology topology = detect_topology();
+  return topology;
+}
+
+bool pin_current_thread([[maybe_unused]] int cpu) {
+#ifdef __linux__
+  if (cpu < 0 || cpu >= CPU_SETSIZE) {
+    return false;
+  }
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  return false;
+#endif
+}
+
+bool unpin_current_thread() {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : cpu_topology().cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &set);
+    }
+  }
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  return false;
+#endif
+}
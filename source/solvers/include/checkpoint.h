@@ -0,0 +1,113 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/// \brief Where and how often a long run saves its state.
+struct CheckpointOptions {
+  /// Checkpointing is disabled when empty.
+  std::filesystem::path path;
+  /// Generations (or iterations) between two checkpoints.
+  int interval = 100;
+  /// Continue from the checkpoint at `path`, if there is one.
+  bool resume = false;
+
+  bool enabled() const { return !path.empty() && interval > 0; }
+};
+
+/// \brief Takes the `--checkpoint=path`, `--checkpoint-interval=N` and
+/// `--resume` options, std::nullopt if they are invalid.
+std::optional<CheckpointOptions> take_checkpoint_options(int& argc,
+                                                         char* argv[]);
+
+/// \brief Identifies the run a checkpoint belongs to: the set, the target,
+/// the objective and the algorithm parameters that shape the saved state.
+/// A run is never resumed against a different one.
+uint64_t problem_fingerprint(const std::vector<int>& set,
+                             int target,
+                             std::string_view objective_name,
+                             std::span<const uint64_t> parameters);
+
+/// \brief problem_fingerprint() for an objective policy, including the
+/// cardinality of the cardinality objective.
+template <typename ObjectivePolicy>
+uint64_t problem_fingerprint(const std::vector<int>& set,
+                             int target,
+                             const ObjectivePolicy& objective,
+                             std::initializer_list<uint64_t> parameters) {
+  uint64_t cardinality = 0;
+  if constexpr (requires { objective.size; }) {
+    cardinality = objective.size;
+  }
+
+  std::vector<uint64_t> all = {cardinality};
+  all.insert(all.end(), parameters.begin(), parameters.end());
+  return problem_fingerprint(set, target, objective.name, all);
+}
+
+struct GeneticCheckpoint {
+  uint64_t fingerprint = 0;
+  int generation = 0;
+  std::vector<std::vector<bool>> population;
+  std::vector<double> population_fitness;
+  std::vector<bool> best_mask;
+  double best_fitness = 0.0;
+  std::vector<double> fitness_history;
+  std::string random_state;
+};
+
+struct TabuCheckpoint {
+  uint64_t fingerprint = 0;
+  int iteration = 0;
+  std::vector<bool> current_mask;
+  std::vector<bool> best_mask;
+  long long best_loss = 0;
+  std::vector<std::vector<bool>> tabu_mask_list;
+  std::vector<double> fitness_history;
+  std::string random_state;
+};
+
+/// \brief Compact binary encoding. Masks are packed 64 bits per word.
+std::string serialize_checkpoint(const GeneticCheckpoint& checkpoint);
+std::string serialize_checkpoint(const TabuCheckpoint& checkpoint);
+
+/// \brief Reads a checkpoint file, std::nullopt if it does not exist. Throws
+/// std::invalid_argument if the file is corrupt or of another kind.
+std::optional<GeneticCheckpoint> load_genetic_checkpoint(
+    const std::filesystem::path& path);
+std::optional<TabuCheckpoint> load_tabu_checkpoint(
+    const std::filesystem::path& path);
+
+/// \brief Writes checkpoints on a background thread, so the search loop only
+/// pays for serializing its state. Only the newest pending checkpoint is
+/// kept. Files are replaced atomically, a crash mid-write keeps the previous
+/// checkpoint intact.
+class CheckpointWriter {
+ public:
+  explicit CheckpointWriter(std::filesystem::path path);
+  ~CheckpointWriter();
+
+  CheckpointWriter(const CheckpointWriter&) = delete;
+  CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+  void write(std::string data);
+
+ private:
+  void run();
+
+  std::filesystem::path path_;
+  std::mutex mutex_;
+  std::condition_variable pending_changed_;
+  std::optional<std::string> pending_;
+  bool stopping_ = false;
+  std::thread thread_;
+};
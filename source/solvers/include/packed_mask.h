@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "subset_sum.h"
+
+/// \brief Subset mask packed 64 bits per word, so operators can work on a
+/// whole word at a time. Bits past size() are always zero.
+class PackedMask {
+ public:
+  static constexpr size_t WORD_BITS = 64;
+
+  PackedMask() = default;
+  explicit PackedMask(size_t size)
+      : size_(size), words_((size + WORD_BITS - 1) / WORD_BITS) {}
+  explicit PackedMask(const std::vector<bool>& mask);
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  std::vector<uint64_t>& words() { return words_; }
+  const std::vector<uint64_t>& words() const { return words_; }
+
+  bool test(size_t index) const {
+    return (words_[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+  }
+
+  void flip(size_t index) {
+    words_[index / WORD_BITS] ^= 1ULL << (index % WORD_BITS);
+  }
+
+  std::vector<bool> to_vector() const;
+
+  bool operator==(const PackedMask&) const = default;
+
+ private:
+  size_t size_ = 0;
+  std::vector<uint64_t> words_;
+};
+
+/// \brief Evaluates the subset selected by a packed mask, visiting only the
+/// set bits.
+SubsetState evaluate_mask(const std::vector<int>& set, const PackedMask& mask);
+
+/// \brief Swaps bits [begin, end) between two masks of the same size, a word
+/// at a time.
+void swap_bit_range(PackedMask& mask1,
+                    PackedMask& mask2,
+                    size_t begin,
+                    size_t end);
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+enum class SelectionMethod {
+  Tournament,
+  Roulette,
+  StochasticUniversal,
+};
+
+std::optional<SelectionMethod> parse_selection_method(std::string_view name);
+
+/// \brief Walker alias table: samples index i with probability
+/// weights[i] / sum(weights) in O(1) after an O(n) build.
+class AliasTable {
+ public:
+  /// \brief Rebuilds the table from non-negative weights. All-zero weights
+  /// give a uniform table.
+  void build(std::span<const double> weights);
+
+  /// \brief Maps a uniform u in [0, 1) to an index. Nearby u may map to
+  /// unrelated indices, so equally spaced u are not a stratified sample.
+  uint32_t sample(double u) const {
+    double scaled = u * probability_.size();
+    auto column = std::min(static_cast<uint32_t>(scaled),
+                           static_cast<uint32_t>(probability_.size() - 1));
+    return scaled - column < probability_[column] ? column : alias_[column];
+  }
+
+  size_t size() const { return probability_.size(); }
+
+ private:
+  std::vector<double> probability_;
+  std::vector<uint32_t> alias_;
+  // Scratch space for build(), kept to avoid reallocating every generation.
+  std::vector<double> scaled_;
+  std::vector<uint32_t> small_;
+  std::vector<uint32_t> large_;
+};
+
+/// \brief Picks the parents of a whole generation at once, as indices into
+/// the population. Nothing is copied, the caller copies only the parents
+/// it breeds from.
+class ParentSelector {
+ public:
+  explicit ParentSelector(SelectionMethod method, size_t tournament_size = 2);
+
+  /// \brief Fills `parents` with indices of parents chosen by fitness, the
+  /// proportional methods expect non-negative fitness.
+  void select(std::span<const double> fitness, std::span<uint32_t> parents);
+
+ private:
+  void select_tournament(std::span<const double> fitness,
+                         std::span<uint32_t> parents);
+  void select_roulette(std::span<const double> fitness,
+                       std::span<uint32_t> parents);
+  void select_stochastic_universal(std::span<const double> fitness,
+                                   std::span<uint32_t> parents);
+
+  SelectionMethod method_;
+  size_t tournament_size_;
+  AliasTable table_;
+  std::vector<uint32_t> candidates_;
+};
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "checkpoint.h"
+#include "objective.h"
+#include "seeding.h"
+#include "selection.h"
+#include "subset_sum.h"
+#include "telemetry.h"
+
+enum class TemperatureFunction {
+  Linear,
+  Logarithmic,
+};
+
+enum class CrossoverMethod {
+  SinglePoint,
+  TwoPoint,
+  Uniform,
+};
+
+enum class MutationMethod {
+  SingleBitFlip,
+  ProbableBitFlip,
+};
+
+enum class TerminationMethod {
+  MaxGenerations,
+  FitnessThreshold,
+};
+
+std::optional<TemperatureFunction> parse_temperature_function(
+    std::string_view name);
+std::optional<CrossoverMethod> parse_crossover_method(std::string_view name);
+std::optional<MutationMethod> parse_mutation_method(std::string_view name);
+std::optional<TerminationMethod> parse_termination_method(
+    std::string_view name);
+
+struct FullSearchOptions {
+  size_t thread_count = 1;
+  TelemetryOptions telemetry = {};
+};
+
+struct BranchAndBoundOptions {
+  size_t thread_count = 1;
+  TelemetryOptions telemetry = {};
+};
+
+struct FptasOptions {
+  /// The subset found is within a factor 1 + epsilon of the best one.
+  double epsilon = 0.1;
+  size_t thread_count = 1;
+  /// Bytes the trimmed lists may use. A lower limit coarsens the trimming,
+  /// trading accuracy for memory and time, and the bound reflects it.
+  size_t memory_limit = size_t{1} << 30;
+  TelemetryOptions telemetry = {};
+};
+
+struct HillClimbingOptions {
+  SeedingMethod seeding_method = SeedingMethod::Random;
+  int max_iterations = std::numeric_limits<int>::max();
+  TelemetryOptions telemetry = {};
+};
+
+struct SimAnnealingOptions {
+  TemperatureFunction temperature_function = TemperatureFunction::Linear;
+  SeedingMethod seeding_method = SeedingMethod::Random;
+  int max_iterations = 1000;
+  TelemetryOptions telemetry = {};
+};
+
+struct TabuSearchOptions {
+  /// Unlimited when not set.
+  std::optional<size_t> max_tabu_size = std::nullopt;
+  SeedingMethod seeding_method = SeedingMethod::Random;
+  int max_iterations = 1000;
+  CheckpointOptions checkpoint = {};
+  TelemetryOptions telemetry = {};
+};
+
+struct GeneticOptions {
+  int population_count = 100;
+  CrossoverMethod crossover_method = CrossoverMethod::SinglePoint;
+  MutationMethod mutation_method = MutationMethod::SingleBitFlip;
+  TerminationMethod termination_method = TerminationMethod::MaxGenerations;
+  SeedingMethod seeding_method = SeedingMethod::Random;
+  SelectionMethod selection_method = SelectionMethod::Tournament;
+  int max_generations = 10000;
+  /// Hard cap on generations, whatever the termination method.
+  int generation_budget = std::numeric_limits<int>::max();
+  /// Breeds and evaluates every generation in parallel.
+  bool parallel = false;
+  /// Workers used when `parallel` is set.
+  size_t thread_count = 1;
+  CheckpointOptions checkpoint = {};
+  TelemetryOptions telemetry = {};
+};
+
+/// \brief Exhaustive search over all 2^n subsets (n < 64).
+SubsetSumResult full_search(const std::vector<int>& set,
+                            int target,
+                            const Objective& objective,
+                            const FullSearchOptions& options);
+
+/// \brief Exact depth-first branch and bound.
+SubsetSumResult branch_and_bound(const std::vector<int>& set,
+                                 int target,
+                                 const Objective& objective,
+                                 const BranchAndBoundOptions& options);
+
+/// \brief Trimmed-list FPTAS for non-negative sets. Reports a proven
+/// lower bound on the best loss in `loss_bound`.
+SubsetSumResult fptas(const std::vector<int>& set,
+                      int target,
+                      const Objective& objective,
+                      const FptasOptions& options);
+
+SubsetSumResult hill_climbing(const std::vector<int>& set,
+                              int target,
+                              const Objective& objective,
+                              const HillClimbingOptions& options);
+
+SubsetSumResult sim_annealing(const std::vector<int>& set,
+                              int target,
+                              const Objective& objective,
+                              const SimAnnealingOptions& options);
+
+SubsetSumResult tabu_search(const std::vector<int>& set,
+                            int target,
+                            const Objective& objective,
+                            const TabuSearchOptions& options);
+
+SubsetSumResult genetic_algorithm(const std::vector<int>& set,
+                                  int target,
+                                  const Objective& objective,
+                                  const GeneticOptions& options);
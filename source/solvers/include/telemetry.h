@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "ring_buffer.h"
+
+/// \brief Where and how often a solver reports its progress while it runs.
+struct TelemetryOptions {
+  /// "stderr" or a file path. Telemetry is disabled when empty.
+  std::string destination;
+  /// Time between two drains of the sample buffer, and between two samples
+  /// while the best loss does not change.
+  std::chrono::milliseconds interval{100};
+
+  bool enabled() const { return !destination.empty(); }
+};
+
+/// \brief Takes the `--telemetry[=stderr/path]` and `--telemetry-interval=ms`
+/// options, std::nullopt if they are invalid.
+std::optional<TelemetryOptions> take_telemetry_options(int& argc,
+                                                       char* argv[]);
+
+struct TelemetrySample {
+  long long iteration = 0;
+  long long best_loss = 0;
+  double elapsed_ms = 0.0;
+};
+
+/// \brief Streams (iteration, best_loss, elapsed) samples of a running solver
+/// as NDJSON, one object per line.
+///
+/// The solver loop only pushes into a lock-free ring buffer, a background
+/// thread drains it to the destination, so the loop never waits for I/O.
+/// A sample is taken whenever the best loss improves and otherwise once per
+/// interval. When the buffer is full the sample is dropped. Pushes must come
+/// from one thread at a time.
+class TelemetryStream {
+ public:
+  /// \brief Throws std::invalid_argument if the destination file cannot
+  /// be opened.
+  explicit TelemetryStream(const TelemetryOptions& options);
+  ~TelemetryStream();
+
+  TelemetryStream(const TelemetryStream&) = delete;
+  TelemetryStream& operator=(const TelemetryStream&) = delete;
+
+  void push(long long iteration, long long best_loss) {
+    if (!enabled_) {
+      return;
+    }
+
+    // Only look at the clock every few calls when nothing improved, cheap
+    // loops call this once per iteration.
+    if (best_loss >= last_loss_ && (++calls_ & 0xFF) != 0) {
+      return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (best_loss >= last_loss_ && now - last_sample_ < interval_) {
+      return;
+    }
+
+    last_loss_ = best_loss;
+    last_sample_ = now;
+    if (!samples_.try_push(
+            {iteration, best_loss,
+             std::chrono::duration<double, std::milli>(now - start_)
+                 .count()})) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  void run();
+  void drain();
+
+  bool enabled_;
+  std::chrono::milliseconds interval_;
+  std::chrono::steady_clock::time_point start_;
+
+  // Producer side.
+  long long last_loss_ = std::numeric_limits<long long>::max();
+  std::chrono::steady_clock::time_point last_sample_;
+  unsigned calls_ = 0;
+
+  RingBuffer<TelemetrySample> samples_;
+  std::atomic<size_t> dropped_{0};
+
+  // Consumer side.
+  std::ofstream file_;
+  std::mutex mutex_;
+  std::condition_variable stop_requested_;
+  bool stopping_ = false;
+  std::thread thread_;
+};
@@ -0,0 +1,222 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+#include "solvers.h"
+#include "thread_pool.h"
+
+namespace {
+
+/// Subtrees with fewer levels left than this are never handed to the pool.
+constexpr size_t MIN_SPLIT_LEVELS = 16;
+
+/// \brief Depth-first branch and bound over the values sorted in descending
+/// order. The best loss is shared between all subtrees, so a good solution
+/// found in one of them immediately tightens the pruning in the others.
+///
+/// While fewer than `max_open_tasks` tasks are queued or running, a node
+/// hands its second branch to the pool instead of walking it itself. A
+/// large subtree keeps splitting until every worker has work again.
+template <typename Objective>
+struct BranchAndBound {
+  std::vector<int> values;                 // sorted, descending
+  std::vector<size_t> original_index;      // position of values[i] in the set
+  std::vector<long long> suffix_positive;  // sum of positive values[i..]
+  std::vector<long long> suffix_negative;  // sum of negative values[i..]
+  int target;
+  Objective objective;
+
+  std::atomic<long long> best_loss;
+  std::atomic<long long> nodes_visited{0};
+  std::mutex best_mutex;
+  std::vector<bool> best_chosen;
+  std::vector<double> fitness_history;
+  TelemetryStream telemetry;  // pushed to under best_mutex
+
+  ThreadPool* pool = nullptr;
+  size_t max_open_tasks = 0;
+  std::atomic<size_t> open_tasks{0};
+
+  BranchAndBound(const std::vector<int>& set,
+                 int target,
+                 const Objective& objective,
+                 const TelemetryOptions& telemetry_options)
+      : target(target),
+        objective(objective),
+        best_loss(std::numeric_limits<long long>::max()),
+        telemetry(telemetry_options) {
+    original_index.resize(set.size());
+    std::iota(original_index.begin(), original_index.end(), 0);
+    std::ranges::stable_sort(original_index, [&](size_t a, size_t b) {
+      return set[a] > set[b];
+    });
+
+    for (size_t idx : original_index) {
+      values.push_back(set[idx]);
+    }
+
+    suffix_positive.assign(values.size() + 1, 0);
+    suffix_negative.assign(values.size() + 1, 0);
+    for (size_t i = values.size(); i-- > 0;) {
+      suffix_positive[i] = suffix_positive[i + 1] + std::max(values[i], 0);
+      suffix_negative[i] = suffix_negative[i + 1] + std::min(values[i], 0);
+    }
+  }
+
+  /// Smallest loss reachable by extending a partial solution at `depth`.
+  long long lower_bound(size_t depth, long long sum, size_t size) const {
+    return objective.lower_bound(
+        sum + suffix_negative[depth], sum + suffix_positive[depth], size,
+        size + (values.size() - depth), target);
+  }
+
+  void offer(long long sum, size_t size, const std::vector<bool>& chosen) {
+    long long curr_loss = objective.loss(sum, size, target);
+    if (curr_loss >= best_loss.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    std::lock_guard lock(best_mutex);
+    if (curr_loss < best_loss.load(std::memory_order_relaxed)) {
+      best_loss.store(curr_loss, std::memory_order_relaxed);
+      best_chosen = chosen;
+      fitness_history.push_back(1.0 / (1 + curr_loss));
+      telemetry.push(nodes_visited.load(std::memory_order_relaxed),
+                     curr_loss);
+    }
+  }
+
+  void search(size_t depth,
+              long long sum,
+              size_t size,
+              std::vector<bool>& chosen) {
+    nodes_visited.fetch_add(1, std::memory_order_relaxed);
+    offer(sum, size, chosen);
+
+    if (depth == values.size() ||
+        lower_bound(depth, sum, size) >=
+            best_loss.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    // Leaving the value out is handed to an idle worker when there is one.
+    // chosen[depth] is still false here, so a copy describes that branch.
+    bool split = values.size() - depth > MIN_SPLIT_LEVELS &&
+                 open_tasks.load(std::memory_order_relaxed) < max_open_tasks;
+    if (split) {
+      spawn(depth + 1, sum, size, chosen);
+    }
+
+    // Taking the value first walks towards the target fastest.
+    chosen[depth] = true;
+    search(depth + 1, sum + values[depth], size + 1, chosen);
+    chosen[depth] = false;
+
+    if (split || best_loss.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+
+    search(depth + 1, sum, size, chosen);
+  }
+
+  /// \brief Queues the subtree below a node on the pool.
+  void spawn(size_t depth,
+             long long sum,
+             size_t size,
+             std::vector<bool> chosen) {
+    open_tasks.fetch_add(1, std::memory_order_relaxed);
+    pool->submit([this, depth, sum, size, chosen = std::move(chosen)] mutable {
+      if (best_loss.load(std::memory_order_relaxed) != 0) {
+        search(depth, sum, size, chosen);
+      }
+      open_tasks.fetch_sub(1, std::memory_order_relaxed);
+    });
+  }
+
+  std::vector<bool> best_mask() const {
+    std::vector<bool> mask(values.size());
+    for (size_t i = 0; i < best_chosen.size(); ++i) {
+      mask[original_index[i]] = best_chosen[i];
+    }
+    return mask;
+  }
+};
+
+template <typename Objective>
+SubsetSumResult run_branch_and_bound(const std::vector<int>& set,
+                                     int target,
+                                     const Objective& objective,
+                                     const BranchAndBoundOptions& options) {
+  size_t thread_count = std::max<size_t>(options.thread_count, 1);
+  BranchAndBound bnb(set, target, objective, options.telemetry);
+
+  // Start from the greedy fill, so the pruning has a bound to work with
+  // from the very first node.
+  auto greedy_mask = generate_greedy_solution_mask(set, target);
+  std::vector<bool> greedy_chosen(set.size());
+  long long greedy_sum = 0;
+  size_t greedy_size = 0;
+  for (size_t i = 0; i < set.size(); ++i) {
+    greedy_chosen[i] = greedy_mask[bnb.original_index[i]];
+    if (greedy_chosen[i]) {
+      greedy_sum += bnb.values[i];
+      ++greedy_size;
+    }
+  }
+  // The seed counts as a visited node, it is a full evaluation.
+  bnb.nodes_visited.fetch_add(1, std::memory_order_relaxed);
+  bnb.offer(greedy_sum, greedy_size, greedy_chosen);
+
+  // Start with a few subtrees per worker. Uneven subtrees are balanced by
+  // stealing, and by splitting deep nodes once the queues run low.
+  size_t split_depth =
+      std::min<size_t>(set.size(), std::bit_width(thread_count * 8 - 1));
+
+  ThreadPool pool(thread_count);
+  bnb.pool = &pool;
+  bnb.max_open_tasks = thread_count * 2;
+  for (uint64_t prefix = 0; prefix < (1ULL << split_depth); ++prefix) {
+    std::vector<bool> chosen(bnb.values.size());
+    long long sum = 0;
+    size_t size = 0;
+
+    // Bit d of the prefix set means value d is left out, so the first
+    // subtrees are the ones taking the largest values.
+    for (size_t d = 0; d < split_depth; ++d) {
+      if (!(prefix & (1ULL << (split_depth - 1 - d)))) {
+        chosen[d] = true;
+        sum += bnb.values[d];
+        ++size;
+      }
+    }
+
+    bnb.spawn(split_depth, sum, size, std::move(chosen));
+  }
+  pool.wait();
+
+  SubsetSumResult result{
+      .best_subset = get_subset(set, bnb.best_mask()),
+      .fitness_history = bnb.fitness_history,
+      .iterations = static_cast<int>(std::min<long long>(
+          bnb.nodes_visited.load(), std::numeric_limits<int>::max())),
+  };
+
+  return result;
+}
+
+}  // namespace
+
+SubsetSumResult branch_and_bound(const std::vector<int>& set,
+                                 int target,
+                                 const Objective& objective,
+                                 const BranchAndBoundOptions& options) {
+  return std::visit(
+      [&](const auto& policy) {
+        return run_branch_and_bound(set, target, policy, options);
+      },
+      objective);
+}
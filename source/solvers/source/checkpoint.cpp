@@ -0,0 +1,358 @@
+#include "checkpoint.h"
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <print>
+#include <stdexcept>
+#include <type_traits>
+
+#include "helpers.h"
+
+namespace {
+
+constexpr char MAGIC[4] = {'S', 'S', 'C', 'P'};
+constexpr uint32_t VERSION = 1;
+
+enum class CheckpointKind : uint32_t {
+  Genetic = 1,
+  Tabu = 2,
+};
+
+class BinaryWriter {
+ public:
+  template <typename T>
+  void write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    data_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  void write_string(const std::string& value) {
+    write<uint64_t>(value.size());
+    data_.append(value);
+  }
+
+  void write_doubles(const std::vector<double>& values) {
+    write<uint64_t>(values.size());
+    data_.append(reinterpret_cast<const char*>(values.data()),
+                 values.size() * sizeof(double));
+  }
+
+  void write_mask(const std::vector<bool>& mask) {
+    write<uint64_t>(mask.size());
+
+    uint64_t word = 0;
+    for (size_t i = 0; i < mask.size(); ++i) {
+      word |= static_cast<uint64_t>(mask[i]) << (i % 64);
+      if (i % 64 == 63) {
+        write(word);
+        word = 0;
+      }
+    }
+    if (mask.size() % 64 != 0) {
+      write(word);
+    }
+  }
+
+  void write_masks(const std::vector<std::vector<bool>>& masks) {
+    write<uint64_t>(masks.size());
+    for (const auto& mask : masks) {
+      write_mask(mask);
+    }
+  }
+
+  std::string take() { return std::move(data_); }
+
+ private:
+  std::string data_;
+};
+
+class BinaryReader {
+ public:
+  explicit BinaryReader(std::string data) : data_(std::move(data)) {}
+
+  template <typename T>
+  T read() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value;
+    std::memcpy(&value, take(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  std::string read_string() {
+    auto size = read<uint64_t>();
+    return std::string(take(size), size);
+  }
+
+  std::vector<double> read_doubles() {
+    auto size = read<uint64_t>();
+    check_remaining(size, sizeof(double));
+    std::vector<double> values(size);
+    std::memcpy(values.data(), take(size * sizeof(double)),
+                size * sizeof(double));
+    return values;
+  }
+
+  std::vector<bool> read_mask() {
+    auto size = read<uint64_t>();
+    check_remaining(size / 64 + (size % 64 != 0), sizeof(uint64_t));
+    std::vector<bool> mask(size);
+
+    uint64_t word = 0;
+    for (size_t i = 0; i < size; ++i) {
+      if (i % 64 == 0) {
+        word = read<uint64_t>();
+      }
+      mask[i] = (word >> (i % 64)) & 1;
+    }
+
+    return mask;
+  }
+
+  std::vector<std::vector<bool>> read_masks() {
+    auto count = read<uint64_t>();
+    std::vector<std::vector<bool>> masks;
+    for (uint64_t i = 0; i < count; ++i) {
+      masks.push_back(read_mask());
+    }
+    return masks;
+  }
+
+ private:
+  /// Rejects a length read from the file before anything is allocated for
+  /// it, so a corrupt length cannot ask for more memory than the file has.
+  void check_remaining(uint64_t count, size_t item_size) const {
+    if (count > (data_.size() - offset_) / item_size) {
+      throw std::invalid_argument("Truncated checkpoint");
+    }
+  }
+
+  const char* take(size_t size) {
+    if (size > data_.size() - offset_) {
+      throw std::invalid_argument("Truncated checkpoint");
+    }
+    const char* start = data_.data() + offset_;
+    offset_ += size;
+    return start;
+  }
+
+  std::string data_;
+  size_t offset_ = 0;
+};
+
+void write_header(BinaryWriter& writer,
+                  CheckpointKind kind,
+                  uint64_t fingerprint) {
+  writer.write(MAGIC);
+  writer.write(VERSION);
+  writer.write(kind);
+  writer.write(fingerprint);
+}
+
+/// Checks the header of a checkpoint, returning its fingerprint.
+uint64_t read_header(BinaryReader& reader,
+                     CheckpointKind kind,
+                     const std::filesystem::path& path) {
+  auto magic = reader.read<std::array<char, 4>>();
+  if (std::memcmp(magic.data(), MAGIC, sizeof(MAGIC)) != 0 ||
+      reader.read<uint32_t>() != VERSION ||
+      reader.read<CheckpointKind>() != kind) {
+    throw std::invalid_argument("Not a compatible checkpoint: " +
+                                path.string());
+  }
+
+  return reader.read<uint64_t>();
+}
+
+std::optional<std::string> read_checkpoint_file(
+    const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return std::nullopt;
+  }
+
+  return std::string(std::istreambuf_iterator<char>(file), {});
+}
+
+}  // namespace
+
+std::optional<CheckpointOptions> take_checkpoint_options(int& argc,
+                                                         char* argv[]) {
+  auto path = take_option(argc, argv, "checkpoint");
+  auto interval = take_option(argc, argv, "checkpoint-interval");
+  auto resume = take_option(argc, argv, "resume");
+
+  CheckpointOptions options;
+  if (path.has_value()) {
+    if (path->empty()) {
+      return std::nullopt;
+    }
+    options.path = *path;
+  }
+
+  if (interval.has_value()) {
+    if (interval->empty() || convert_type<int>(*interval) <= 0) {
+      return std::nullopt;
+    }
+    options.interval = convert_type<int>(*interval);
+  }
+
+  options.resume = resume.has_value();
+  if (options.resume && options.path.empty()) {
+    return std::nullopt;
+  }
+
+  return options;
+}
+
+uint64_t problem_fingerprint(const std::vector<int>& set,
+                             int target,
+                             std::string_view objective_name,
+                             std::span<const uint64_t> parameters) {
+  // FNV-1a over the target, the values, the objective and the parameters.
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  auto mix = [&](uint64_t value) {
+    hash ^= value;
+    hash *= 0x100000001b3ULL;
+  };
+
+  mix(static_cast<uint32_t>(target));
+  for (int value : set) {
+    mix(static_cast<uint32_t>(value));
+  }
+  for (char c : objective_name) {
+    mix(static_cast<unsigned char>(c));
+  }
+  for (uint64_t parameter : parameters) {
+    mix(parameter);
+  }
+
+  return hash;
+}
+
+std::string serialize_checkpoint(const GeneticCheckpoint& checkpoint) {
+  BinaryWriter writer;
+  write_header(writer, CheckpointKind::Genetic, checkpoint.fingerprint);
+  writer.write(checkpoint.generation);
+  writer.write_masks(checkpoint.population);
+  writer.write_doubles(checkpoint.population_fitness);
+  writer.write_mask(checkpoint.best_mask);
+  writer.write(checkpoint.best_fitness);
+  writer.write_doubles(checkpoint.fitness_history);
+  writer.write_string(checkpoint.random_state);
+
+  return writer.take();
+}
+
+std::string serialize_checkpoint(const TabuCheckpoint& checkpoint) {
+  BinaryWriter writer;
+  write_header(writer, CheckpointKind::Tabu, checkpoint.fingerprint);
+  writer.write(checkpoint.iteration);
+  writer.write_mask(checkpoint.current_mask);
+  writer.write_mask(checkpoint.best_mask);
+  writer.write(checkpoint.best_loss);
+  writer.write_masks(checkpoint.tabu_mask_list);
+  writer.write_doubles(checkpoint.fitness_history);
+  writer.write_string(checkpoint.random_state);
+
+  return writer.take();
+}
+
+std::optional<GeneticCheckpoint> load_genetic_checkpoint(
+    const std::filesystem::path& path) {
+  auto data = read_checkpoint_file(path);
+  if (!data.has_value()) {
+    return std::nullopt;
+  }
+
+  BinaryReader reader(std::move(*data));
+  GeneticCheckpoint checkpoint;
+  checkpoint.fingerprint = read_header(reader, CheckpointKind::Genetic, path);
+  checkpoint.generation = reader.read<int>();
+  checkpoint.population = reader.read_masks();
+  checkpoint.population_fitness = reader.read_doubles();
+  checkpoint.best_mask = reader.read_mask();
+  checkpoint.best_fitness = reader.read<double>();
+  checkpoint.fitness_history = reader.read_doubles();
+  checkpoint.random_state = reader.read_string();
+
+  return checkpoint;
+}
+
+std::optional<TabuCheckpoint> load_tabu_checkpoint(
+    const std::filesystem::path& path) {
+  auto data = read_checkpoint_file(path);
+  if (!data.has_value()) {
+    return std::nullopt;
+  }
+
+  BinaryReader reader(std::move(*data));
+  TabuCheckpoint checkpoint;
+  checkpoint.fingerprint = read_header(reader, CheckpointKind::Tabu, path);
+  checkpoint.iteration = reader.read<int>();
+  checkpoint.current_mask = reader.read_mask();
+  checkpoint.best_mask = reader.read_mask();
+  checkpoint.best_loss = reader.read<long long>();
+  checkpoint.tabu_mask_list = reader.read_masks();
+  checkpoint.fitness_history = reader.read_doubles();
+  checkpoint.random_state = reader.read_string();
+
+  return checkpoint;
+}
+
+CheckpointWriter::CheckpointWriter(std::filesystem::path path)
+    : path_(std::move(path)), thread_([this] { run(); }) {}
+
+CheckpointWriter::~CheckpointWriter() {
+  {
+    std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  pending_changed_.notify_one();
+  thread_.join();
+}
+
+void CheckpointWriter::write(std::string data) {
+  {
+    std::lock_guard lock(mutex_);
+    pending_ = std::move(data);
+  }
+  pending_changed_.notify_one();
+}
+
+void CheckpointWriter::run() {
+  auto temp_path = path_;
+  temp_path += ".tmp";
+
+  while (true) {
+    std::string data;
+    {
+      std::unique_lock lock(mutex_);
+      pending_changed_.wait(
+          lock, [this] { return stopping_ || pending_.has_value(); });
+      if (!pending_.has_value()) {
+        return;
+      }
+      data = std::move(*pending_);
+      pending_.reset();
+    }
+
+    {
+      std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+      file.write(data.data(), data.size());
+      if (!file) {
+        std::print(stderr, "Failed to write checkpoint: {}\n",
+                   temp_path.string());
+        continue;
+      }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temp_path, path_, error);
+    if (error) {
+      std::print(stderr, "Failed to write checkpoint: {}\n", error.message());
+    }
+  }
+}
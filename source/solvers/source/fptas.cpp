@@ -0,0 +1,330 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "solvers.h"
+#include "thread_pool.h"
+
+namespace {
+
+/// Sorted list of subset sums, every one of them exact.
+using SumList = std::vector<long long>;
+
+/// Smallest merge worth handing to another worker.
+constexpr size_t MIN_CHUNK = 1 << 14;
+
+/// \brief Builds the trimmed lists of the FPTAS: L_i is L_{i-1} merged
+/// with L_{i-1} + value_i, with sums above the cap dropped and every sum
+/// within a factor 1 + delta of the previous kept one trimmed.
+///
+/// The merged list is split into at most one chunk per worker by merge
+/// path, and every chunk merges and trims on its own. Each chunk keeps its
+/// first sum, so a list holds at most 2 + log_{1+delta}(cap) sums plus one
+/// per extra chunk. Chunking only depends on the list size, so recomputing
+/// a level gives the same list.
+class TrimmedLists {
+ public:
+  TrimmedLists(long long cap, double delta, ThreadPool& pool)
+      : cap_(cap), delta_(delta), pool_(pool) {}
+
+  /// \brief Upper bound on the length of any list.
+  static size_t max_length(long long cap, double delta, size_t workers) {
+    if (cap <= 0) {
+      return 1;
+    }
+    double steps = std::log(static_cast<double>(cap)) / std::log1p(delta);
+    return 2 + static_cast<size_t>(steps) + (workers - 1);
+  }
+
+  void next(const SumList& list, long long value, SumList& out) {
+    auto shifted_count = static_cast<size_t>(
+        std::upper_bound(list.begin(), list.end(), cap_ - value) -
+        list.begin());
+    size_t total = list.size() + shifted_count;
+
+    size_t chunk_count =
+        std::clamp<size_t>(total / MIN_CHUNK, 1, pool_.size());
+    scratch_.resize(total);
+    kept_.assign(chunk_count, 0);
+
+    // Merge and trim every chunk into its own range of the scratch list.
+    auto chunk_begin = [&](size_t chunk) {
+      return total * chunk / chunk_count;
+    };
+    auto merge_chunk = [&, value, shifted_count](size_t chunk) {
+      size_t begin = chunk_begin(chunk);
+      size_t end = chunk_begin(chunk + 1);
+
+      // Merge path: i sums from the list and begin - i shifted sums come
+      // first, ties going to the list.
+      size_t low = begin > shifted_count ? begin - shifted_count : 0;
+      size_t high = std::min(begin, list.size());
+      while (low < high) {
+        size_t i = (low + high) / 2;
+        if (list[i] <= list[begin - i - 1] + value) {
+          low = i + 1;
+        } else {
+          high = i;
+        }
+      }
+
+      size_t i = low;
+      size_t j = begin - low;
+      long long* first = scratch_.data() + begin;
+      long long* last = first;
+      double threshold = -1.0;
+      for (size_t k = begin; k < end; ++k) {
+        long long sum;
+        if (j == shifted_count ||
+            (i < list.size() && list[i] <= list[j] + value)) {
+          sum = list[i++];
+        } else {
+          sum = list[j++] + value;
+        }
+
+        if (sum > threshold) {
+          *last++ = sum;
+          threshold = sum * (1.0 + delta_);
+        }
+      }
+      kept_[chunk] = last - first;
+    };
+
+    if (chunk_count == 1) {
+      merge_chunk(0);
+      out.assign(scratch_.begin(), scratch_.begin() + kept_[0]);
+      return;
+    }
+
+    for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+      pool_.submit_to(chunk, [&merge_chunk, chunk] { merge_chunk(chunk); });
+    }
+    pool_.wait();
+
+    // Compact the kept ranges.
+    std::vector<size_t> offsets(chunk_count + 1, 0);
+    std::partial_sum(kept_.begin(), kept_.end(), offsets.begin() + 1);
+    out.resize(offsets.back());
+    for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+      pool_.submit_to(chunk, [&, chunk] {
+        auto first = scratch_.begin() + chunk_begin(chunk);
+        std::copy(first, first + kept_[chunk], out.begin() + offsets[chunk]);
+      });
+    }
+    pool_.wait();
+  }
+
+ private:
+  long long cap_;
+  double delta_;
+  ThreadPool& pool_;
+  SumList scratch_;
+  std::vector<size_t> kept_;
+};
+
+/// \brief Outcome of one FPTAS pass over the positive values.
+struct PassResult {
+  std::vector<bool> chosen;   // over the positive values
+  long long sum = 0;          // largest sum found, at most the cap
+  long long upper_bound = 0;  // no subset sum up to the cap exceeds it
+};
+
+/// \brief Largest subset sum not exceeding `cap`, within a factor
+/// (1 + delta)^n of the best one.
+///
+/// Trimming may drop the largest sum of a list, so the largest sum of any
+/// level is kept, along with the level it was found at. Only the lists at
+/// every k-th level (k ~ sqrt(n)) are stored. The subset is rebuilt
+/// backwards one segment at a time: the segment's lists are recomputed
+/// from its checkpoint, and a sum missing from the previous list must have
+/// taken the value. Memory stays at about 2 sqrt(n) lists for at most twice
+/// the time of the forward pass.
+template <typename OnLevel>
+PassResult run_pass(const std::vector<long long>& values,
+                    long long cap,
+                    double delta,
+                    ThreadPool& pool,
+                    const OnLevel& on_level) {
+  size_t n = values.size();
+  size_t segment = std::max<size_t>(
+      1, static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(n)))));
+  TrimmedLists lists(cap, delta, pool);
+
+  PassResult result;
+  size_t best_level = 0;
+
+  std::vector<SumList> checkpoints;
+  SumList list = {0};
+  SumList next;
+  for (size_t i = 0; i < n; ++i) {
+    if (i % segment == 0) {
+      checkpoints.push_back(list);
+    }
+    lists.next(list, values[i], next);
+    list.swap(next);
+
+    if (list.back() > result.sum) {
+      result.sum = list.back();
+      best_level = i + 1;
+    }
+    on_level(i, result.sum);
+  }
+
+  // Every sum up to the cap is within the factor of a sum in the last list.
+  // The trimming thresholds are rounded once per level, so the factor is
+  // widened by a few units in the last place per level and the product is
+  // rounded up: the bound may be a little loose, never too tight.
+  double slack = 1.0 + 4.0 * static_cast<double>(n + 1) *
+                           std::numeric_limits<double>::epsilon();
+  double factor = std::exp(static_cast<double>(n) * std::log1p(delta)) * slack;
+  double bound = std::ceil(static_cast<double>(list.back()) * factor);
+  result.upper_bound =
+      bound >= static_cast<double>(cap) ? cap : static_cast<long long>(bound);
+
+  result.chosen.assign(n, false);
+  long long remaining = result.sum;
+  std::vector<SumList> levels;
+  for (size_t s = (best_level + segment - 1) / segment; s-- > 0;) {
+    size_t begin = s * segment;
+    size_t end = std::min(begin + segment, best_level);
+
+    levels.resize(end - begin);
+    levels[0] = std::move(checkpoints[s]);
+    for (size_t i = begin + 1; i < end; ++i) {
+      lists.next(levels[i - begin - 1], values[i - 1], levels[i - begin]);
+    }
+
+    for (size_t i = end; i-- > begin;) {
+      const auto& previous = levels[i - begin];
+      if (!std::binary_search(previous.begin(), previous.end(), remaining)) {
+        remaining -= values[i];
+        result.chosen[i] = true;
+      }
+    }
+  }
+
+  if (remaining != 0) {
+    throw std::logic_error("FPTAS failed to rebuild the subset");
+  }
+
+  return result;
+}
+
+template <typename Objective>
+SubsetSumResult run_fptas(const std::vector<int>& set,
+                          int target,
+                          const Objective& /*objective*/,
+                          const FptasOptions& options) {
+  if constexpr (std::is_same_v<Objective, CardinalityObjective>) {
+    throw std::invalid_argument(
+        "FPTAS supports the absolute and under_target objectives");
+  } else {
+    if (target < 0 || std::ranges::any_of(set, [](int v) { return v < 0; })) {
+      throw std::invalid_argument("FPTAS needs a non-negative set and target");
+    }
+    if (!(options.epsilon > 0.0)) {
+      throw std::invalid_argument("FPTAS needs a positive epsilon");
+    }
+
+    // Zeros never change a sum, the lists only see the positive values.
+    std::vector<long long> values;
+    std::vector<size_t> original_index;
+    for (size_t i = 0; i < set.size(); ++i) {
+      if (set[i] > 0) {
+        values.push_back(set[i]);
+        original_index.push_back(i);
+      }
+    }
+    size_t n = values.size();
+    long long total = std::accumulate(values.begin(), values.end(), 0LL);
+
+    // Sums at least the target are complements of sums at most
+    // total - target, so the absolute objective takes a second pass.
+    constexpr bool two_sided = std::is_same_v<Objective, AbsoluteObjective>;
+    long long over_cap = two_sided && total >= target ? total - target : -1;
+    long long largest_cap = std::max<long long>(target, over_cap);
+
+    size_t thread_count = std::max<size_t>(options.thread_count, 1);
+    ThreadPool pool(thread_count);
+
+    // delta = epsilon / 2n keeps (1 + delta)^n below 1 + epsilon. The
+    // checkpoints, the lists of one segment, the current and next list and
+    // the merge scratch (two lists) must fit the memory limit. When they do
+    // not for that delta, delta is widened until they do, and the reported
+    // bound uses the wider delta.
+    double delta = options.epsilon / (2.0 * std::max<size_t>(n, 1));
+    size_t segment = static_cast<size_t>(
+        std::ceil(std::sqrt(static_cast<double>(std::max<size_t>(n, 1)))));
+    size_t list_count = (n + segment - 1) / segment + segment + 4;
+    size_t max_length = options.memory_limit / (list_count * sizeof(long long));
+    if (TrimmedLists::max_length(largest_cap, delta, thread_count) >
+        max_length) {
+      if (max_length < 2 + thread_count) {
+        throw std::invalid_argument("Memory limit too small for the FPTAS");
+      }
+      delta = std::expm1(std::log(static_cast<double>(largest_cap)) /
+                         static_cast<double>(max_length - 1 - thread_count));
+    }
+
+    std::vector<double> fitness_history;
+    TelemetryStream telemetry(options.telemetry);
+    long long best_loss = std::numeric_limits<long long>::max();
+    auto record = [&](size_t iteration, long long curr_loss) {
+      if (curr_loss < best_loss) {
+        best_loss = curr_loss;
+        fitness_history.push_back(1.0 / (1 + curr_loss));
+      }
+      telemetry.push(iteration, best_loss);
+    };
+
+    auto under = run_pass(values, target, delta, pool,
+                          [&](size_t i, long long best_sum) {
+                            record(i, target - best_sum);
+                          });
+    std::vector<bool> chosen = under.chosen;
+    long long loss_bound = target - under.upper_bound;
+
+    if (over_cap >= 0) {
+      auto over = run_pass(values, over_cap, delta, pool,
+                           [&](size_t i, long long best_sum) {
+                             record(n + i, over_cap - best_sum);
+                           });
+      if (over_cap - over.sum < target - under.sum) {
+        chosen = over.chosen;
+        chosen.flip();
+      }
+      loss_bound = std::min(loss_bound, over_cap - over.upper_bound);
+    }
+
+    std::vector<bool> mask(set.size());
+    for (size_t i = 0; i < n; ++i) {
+      mask[original_index[i]] = chosen[i];
+    }
+
+    SubsetSumResult result{
+        .best_subset = get_subset(set, mask),
+        .fitness_history = fitness_history,
+        .iterations = static_cast<int>((over_cap >= 0 ? 2 : 1) * n),
+        .loss_bound = loss_bound,
+    };
+
+    return result;
+  }
+}
+
+}  // namespace
+
+SubsetSumResult fptas(const std::vector<int>& set,
+                      int target,
+                      const Objective& objective,
+                      const FptasOptions& options) {
+  return std::visit(
+      [&](const auto& policy) {
+        return run_fptas(set, target, policy, options);
+      },
+      objective);
+}
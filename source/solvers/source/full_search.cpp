@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "solvers.h"
+#include "thread_pool.h"
+
+namespace {
+
+/// \brief Sum of the values selected by the bits of a mask.
+long long mask_sum(const std::vector<int>& set, uint64_t mask) {
+  long long sum = 0;
+  for (size_t j = 0; j < set.size(); ++j) {
+    if (mask & (1ULL << j)) {
+      sum += set[j];
+    }
+  }
+  return sum;
+}
+
+template <typename Objective>
+SubsetSumResult run_full_search(const std::vector<int>& set,
+                                int target,
+                                const Objective& objective,
+                                const FullSearchOptions& options) {
+  if (set.size() >= 64) {
+    throw std::invalid_argument("Full search supports up to 63 elements");
+  }
+
+  size_t thread_count = std::max<size_t>(options.thread_count, 1);
+  std::vector<double> fitness_history;
+
+  std::atomic<long long> best_loss = std::numeric_limits<long long>::max();
+  std::atomic<uint64_t> visited = 0;
+  uint64_t best_mask = 0;
+  std::mutex best_mutex;
+  TelemetryStream telemetry(options.telemetry);
+
+  // Walk all 2^set_size masks in Gray code order: consecutive masks differ
+  // in exactly one bit, so the sum is updated in O(1) and no mask is ever
+  // stored. Every worker walks a contiguous range.
+  uint64_t all_combinations = 1ULL << set.size();
+  uint64_t range_count = std::min<uint64_t>(thread_count, all_combinations);
+
+  ThreadPool pool(thread_count);
+  uint64_t begin = 0;
+  for (uint64_t r = 0; r < range_count; ++r) {
+    uint64_t end = begin + all_combinations / range_count +
+                   (r < all_combinations % range_count ? 1 : 0);
+
+    pool.submit([&, begin, end] {
+      uint64_t gray = begin ^ (begin >> 1);
+      long long sum = mask_sum(set, gray);
+      size_t size = std::popcount(gray);
+      long long local_best = best_loss.load();
+
+      uint64_t i = begin;
+      for (;;) {
+        long long curr_loss = objective.loss(sum, size, target);
+
+        if (curr_loss < local_best) {
+          std::lock_guard lock(best_mutex);
+          if (curr_loss < best_loss.load()) {
+            best_loss.store(curr_loss);
+            best_mask = gray;
+            fitness_history.push_back(1.0 / (1 + curr_loss));
+            telemetry.push(i, curr_loss);
+          }
+          local_best = best_loss.load();
+        }
+
+        if (++i == end) {
+          break;
+        }
+
+        // Check in with the other workers once in a while.
+        if ((i & 0xFFFF) == 0) {
+          local_best = best_loss.load(std::memory_order_relaxed);
+          if (local_best == 0) {
+            break;
+          }
+        }
+
+        int bit = std::countr_zero(i);
+        gray ^= 1ULL << bit;
+        if (gray & (1ULL << bit)) {
+          sum += set[bit];
+          ++size;
+        } else {
+          sum -= set[bit];
+          --size;
+        }
+      }
+
+      // The loop leaves before evaluating mask i.
+      visited.fetch_add(i - begin, std::memory_order_relaxed);
+    });
+
+    begin = end;
+  }
+  pool.wait();
+
+  std::vector<bool> mask(set.size());
+  for (size_t j = 0; j < set.size(); ++j) {
+    mask[j] = (best_mask & (1ULL << j)) != 0;
+  }
+
+  SubsetSumResult result{
+      .best_subset = get_subset(set, mask),
+      .fitness_history = fitness_history,
+      .iterations = static_cast<int>(std::min<uint64_t>(
+          visited.load(), std::numeric_limits<int>::max())),
+  };
+
+  return result;
+}
+
+}  // namespace
+
+SubsetSumResult full_search(const std::vector<int>& set,
+                            int target,
+                            const Objective& objective,
+                            const FullSearchOptions& options) {
+  return std::visit(
+      [&](const auto& policy) {
+        return run_full_search(set, target, policy, options);
+      },
+      objective);
+}
@@ -0,0 +1,434 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "helpers.h"
+#include "packed_mask.h"
+#include "selection.h"
+#include "solvers.h"
+#include "thread_pool.h"
+
+namespace {
+
+/// Individuals per random block of the parallel GA. Fixed, so the random
+/// sequence of a run does not depend on the pool.
+constexpr size_t SEED_BLOCK = 64;
+
+// Operator policies. The engine is instantiated once per combination, so
+// the per-child operators inline into the breeding loop instead of
+// switching on the method enums for every call.
+
+// The operators work on packed masks, a word (64 bits) at a time.
+
+/// \brief Swaps the tails of the children after a random point.
+struct SinglePointCrossover {
+  static void apply(PackedMask& child1, PackedMask& child2) {
+    size_t point = get_random_int(0, child1.size() - 1);
+    swap_bit_range(child1, child2, point, child1.size());
+  }
+};
+
+/// \brief Swaps the section of the children between two random points.
+struct TwoPointCrossover {
+  static void apply(PackedMask& child1, PackedMask& child2) {
+    size_t point1 = get_random_int(0, child1.size() - 2);
+    size_t point2 = get_random_int(point1 + 1, child1.size() - 1);
+    swap_bit_range(child1, child2, point1, point2 + 1);
+  }
+};
+
+/// \brief Swaps every bit between the children with a 50% chance.
+struct UniformCrossover {
+  static void apply(PackedMask& child1, PackedMask& child2) {
+    auto& words1 = child1.words();
+    auto& words2 = child2.words();
+    for (size_t w = 0; w < words1.size(); ++w) {
+      // Both children are zero past size(), so the padding never changes.
+      uint64_t t = (words1[w] ^ words2[w]) & get_random_bits();
+      words1[w] ^= t;
+      words2[w] ^= t;
+    }
+  }
+};
+
+/// \brief Flips one random bit.
+struct SingleBitFlipMutation {
+  static void apply(PackedMask& mask) {
+    mask.flip(get_random_int(0, mask.size() - 1));
+  }
+};
+
+/// \brief Flips every bit with a 10% chance.
+struct ProbableBitFlipMutation {
+  static constexpr double RATE = 0.1;
+
+  static void apply(PackedMask& mask) {
+    // XOR each word with a sparse random mask. The gaps between its set
+    // bits are geometrically distributed, so this draws one random number
+    // per flip instead of one per bit.
+    static const double log_keep = std::log1p(-RATE);
+    auto skip = [&]() {
+      double gap = std::log1p(-get_random_double(0.0, 1.0)) / log_keep;
+      return gap < mask.size() ? static_cast<size_t>(gap) : mask.size();
+    };
+
+    auto& words = mask.words();
+    for (size_t i = skip(); i < mask.size();) {
+      size_t w = i / PackedMask::WORD_BITS;
+      size_t word_end = std::min((w + 1) * PackedMask::WORD_BITS, mask.size());
+
+      uint64_t flips = 0;
+      for (; i < word_end; i += 1 + skip()) {
+        flips |= 1ULL << (i % PackedMask::WORD_BITS);
+      }
+      words[w] ^= flips;
+    }
+  }
+};
+
+struct MaxGenerationsTermination {
+  static bool should_terminate(const GeneticOptions& options,
+                               int generation,
+                               double /*best_fitness*/) {
+    return generation >= options.max_generations;
+  }
+};
+
+struct FitnessThresholdTermination {
+  static bool should_terminate(const GeneticOptions& /*options*/,
+                               int /*generation*/,
+                               double best_fitness) {
+    return best_fitness > 0.99;  // Assuming fitness is normalized to [0, 1]
+  }
+};
+
+using CrossoverPolicy =
+    std::variant<SinglePointCrossover, TwoPointCrossover, UniformCrossover>;
+using MutationPolicy =
+    std::variant<SingleBitFlipMutation, ProbableBitFlipMutation>;
+using TerminationPolicy =
+    std::variant<MaxGenerationsTermination, FitnessThresholdTermination>;
+
+CrossoverPolicy make_crossover_policy(CrossoverMethod method) {
+  switch (method) {
+    case CrossoverMethod::SinglePoint:
+      return SinglePointCrossover{};
+    case CrossoverMethod::TwoPoint:
+      return TwoPointCrossover{};
+    case CrossoverMethod::Uniform:
+      return UniformCrossover{};
+  }
+
+  return SinglePointCrossover{};
+}
+
+MutationPolicy make_mutation_policy(MutationMethod method) {
+  switch (method) {
+    case MutationMethod::SingleBitFlip:
+      return SingleBitFlipMutation{};
+    case MutationMethod::ProbableBitFlip:
+      return ProbableBitFlipMutation{};
+  }
+
+  return SingleBitFlipMutation{};
+}
+
+TerminationPolicy make_termination_policy(TerminationMethod method) {
+  switch (method) {
+    case TerminationMethod::MaxGenerations:
+      return MaxGenerationsTermination{};
+    case TerminationMethod::FitnessThreshold:
+      return FitnessThresholdTermination{};
+  }
+
+  return MaxGenerationsTermination{};
+}
+
+std::vector<PackedMask> pack_masks(
+    const std::vector<std::vector<bool>>& masks) {
+  return {masks.begin(), masks.end()};
+}
+
+std::vector<std::vector<bool>> unpack_masks(
+    const std::vector<PackedMask>& masks) {
+  std::vector<std::vector<bool>> unpacked;
+  unpacked.reserve(masks.size());
+  for (const auto& mask : masks) {
+    unpacked.push_back(mask.to_vector());
+  }
+  return unpacked;
+}
+
+template <typename Objective,
+          typename Crossover,
+          typename Mutation,
+          typename Termination>
+SubsetSumResult run_genetic_algorithm(const std::vector<int>& set,
+                                      int target,
+                                      const Objective& objective,
+                                      const GeneticOptions& options) {
+  auto should_terminate = [&](int generation, double best_fitness) {
+    return generation >= options.generation_budget ||
+           Termination::should_terminate(options, generation, best_fitness);
+  };
+
+  size_t population_count = std::max(options.population_count, 1);
+  // The termination settings and the thread count may change on resume, to
+  // extend a run or move it to another machine. The serial and the parallel
+  // GA draw different random sequences.
+  auto fingerprint = problem_fingerprint(
+      set, target, objective,
+      {population_count, static_cast<uint64_t>(options.crossover_method),
+       static_cast<uint64_t>(options.mutation_method),
+       static_cast<uint64_t>(options.selection_method),
+       static_cast<uint64_t>(options.parallel)});
+
+  std::vector<double> fitness_history;
+  std::vector<PackedMask> population;
+  std::vector<double> population_fitness;
+
+  int generation = 0;
+  double best_fitness = 0.0;
+  PackedMask best_mask;
+
+  // A checkpoint is taken right after evaluation, so a resumed run picks up
+  // at breeding without re-evaluating or re-checking termination.
+  bool resumed = false;
+  if (options.checkpoint.resume) {
+    if (auto checkpoint = load_genetic_checkpoint(options.checkpoint.path)) {
+      if (checkpoint->fingerprint != fingerprint) {
+        throw std::invalid_argument(
+            "Checkpoint is for a different problem or parameters: " +
+            options.checkpoint.path.string());
+      }
+
+      generation = checkpoint->generation;
+      population = pack_masks(checkpoint->population);
+      population_fitness = std::move(checkpoint->population_fitness);
+      best_mask = PackedMask(checkpoint->best_mask);
+      best_fitness = checkpoint->best_fitness;
+      fitness_history = std::move(checkpoint->fitness_history);
+      load_random_state(checkpoint->random_state);
+      resumed = true;
+    }
+  }
+
+  if (!resumed) {
+    population = pack_masks(generate_initial_population(
+        set, target, population_count, options.seeding_method));
+  }
+
+  std::optional<CheckpointWriter> checkpoint_writer;
+  if (options.checkpoint.enabled()) {
+    checkpoint_writer.emplace(options.checkpoint.path);
+  }
+
+  TelemetryStream telemetry(options.telemetry);
+  long long best_loss =
+      best_mask.empty()
+          ? std::numeric_limits<long long>::max()
+          : loss(evaluate_mask(set, best_mask), target, objective);
+
+  auto evaluate = [&](const PackedMask& mask) {
+    return fitness(evaluate_mask(set, mask), target, objective);
+  };
+
+  // The parallel GA splits every generation into chunks on a pinned pool.
+  // Children are allocated by the worker breeding them, so their words are
+  // first touched on its NUMA node, and a chunk's parents and children fit
+  // in L2. The body runs once per block of SEED_BLOCK individuals and
+  // every block reseeds the worker's engine from a seed the main engine
+  // draws in block order. Chunks are whole blocks, so a run (and a resumed
+  // one) only depends on the main engine, not on the thread count or the
+  // cache size of the machine.
+  std::optional<ThreadPool> pool;
+  if (options.parallel) {
+    pool.emplace(options.thread_count);
+  }
+  size_t mask_bytes = sizeof(PackedMask) + (set.size() + 63) / 64 * 8;
+  std::vector<uint64_t> block_seeds;
+
+  auto for_each_chunk = [&](size_t begin, size_t end, const auto& body) {
+    if (!pool.has_value()) {
+      body(begin, end);
+      return;
+    }
+
+    size_t block_count = (end - begin + SEED_BLOCK - 1) / SEED_BLOCK;
+    block_seeds.resize(block_count);
+    for (auto& seed : block_seeds) {
+      seed = get_random_bits();
+    }
+
+    size_t chunk = pool->chunk_size(end - begin, 3 * mask_bytes);
+    size_t blocks_per_chunk = (chunk + SEED_BLOCK - 1) / SEED_BLOCK;
+    size_t worker = 0;
+    for (size_t first = 0; first < block_count; first += blocks_per_chunk) {
+      size_t last = std::min(first + blocks_per_chunk, block_count);
+      pool->submit_to(worker++, [&, first, last, begin, end] {
+        for (size_t block = first; block < last; ++block) {
+          uint64_t seed = block_seeds[block];
+          std::seed_seq seed_sequence{static_cast<uint32_t>(seed),
+                                      static_cast<uint32_t>(seed >> 32)};
+          random_engine().seed(seed_sequence);
+          body(begin + block * SEED_BLOCK,
+               std::min(begin + (block + 1) * SEED_BLOCK, end));
+        }
+      });
+    }
+    pool->wait();
+  };
+
+  if (!resumed) {
+    population_fitness.resize(population.size());
+    for_each_chunk(0, population.size(), [&](size_t first, size_t last) {
+      for (size_t i = first; i < last; ++i) {
+        population_fitness[i] = evaluate(population[i]);
+      }
+    });
+  }
+
+  std::vector<PackedMask> offspring;
+  std::vector<double> offspring_fitness;
+
+  // Parents are picked for the whole generation up front, as indices.
+  // Child i is bred from parents[i] and parents[i + 1], so the chunks only
+  // copy the masks they breed from.
+  ParentSelector selector(options.selection_method);
+  std::vector<uint32_t> parents(population_count + 1);
+
+  while (resumed || !should_terminate(generation, best_fitness)) {
+    if (!resumed) {
+      bool improved = false;
+      for (size_t i = 0; i < population.size(); ++i) {
+        if (population_fitness[i] > best_fitness) {
+          best_fitness = population_fitness[i];
+          best_mask = population[i];
+          improved = true;
+        }
+      }
+
+      fitness_history.push_back(best_fitness);
+      if (improved) {
+        best_loss = loss(evaluate_mask(set, best_mask), target, objective);
+      }
+      telemetry.push(generation, best_loss);
+
+      if (checkpoint_writer.has_value() &&
+          (generation + 1) % options.checkpoint.interval == 0) {
+        checkpoint_writer->write(serialize_checkpoint(GeneticCheckpoint{
+            .fingerprint = fingerprint,
+            .generation = generation,
+            .population = unpack_masks(population),
+            .population_fitness = population_fitness,
+            .best_mask = best_mask.to_vector(),
+            .best_fitness = best_fitness,
+            .fitness_history = fitness_history,
+            .random_state = save_random_state(),
+        }));
+      }
+    }
+    resumed = false;
+
+    // Breed and evaluate the next generation, the best mask so far is
+    // carried over unchanged.
+    offspring.assign(population_count, PackedMask());
+    offspring_fitness.assign(population_count, 0.0);
+    offspring[0] = best_mask;
+    offspring_fitness[0] = best_fitness;
+
+    selector.select(population_fitness, std::span(parents).subspan(1));
+
+    for_each_chunk(1, population_count, [&](size_t first, size_t last) {
+      for (size_t i = first; i < last; i += 2) {
+        // The children start as copies of their parents and are bred in
+        // place.
+        auto child1 = population[parents[i]];
+        auto child2 = population[parents[i + 1]];
+
+        Crossover::apply(child1, child2);
+        Mutation::apply(child1);
+        Mutation::apply(child2);
+
+        offspring_fitness[i] = evaluate(child1);
+        offspring[i] = std::move(child1);
+        if (i + 1 < last) {
+          offspring_fitness[i + 1] = evaluate(child2);
+          offspring[i + 1] = std::move(child2);
+        }
+      }
+    });
+
+    population.swap(offspring);
+    population_fitness.swap(offspring_fitness);
+    generation++;
+  }
+
+  SubsetSumResult result{
+      .best_subset = get_subset(set, best_mask.to_vector()),
+      .fitness_history = fitness_history,
+      .iterations = generation,
+  };
+
+  return result;
+}
+
+}  // namespace
+
+std::optional<CrossoverMethod> parse_crossover_method(std::string_view name) {
+  if (name == "single_point") {
+    return CrossoverMethod::SinglePoint;
+  } else if (name == "two_point") {
+    return CrossoverMethod::TwoPoint;
+  } else if (name == "uniform") {
+    return CrossoverMethod::Uniform;
+  }
+
+  return std::nullopt;
+}
+
+std::optional<MutationMethod> parse_mutation_method(std::string_view name) {
+  if (name == "single_bit_flip") {
+    return MutationMethod::SingleBitFlip;
+  } else if (name == "probable_bit_flip") {
+    return MutationMethod::ProbableBitFlip;
+  }
+
+  return std::nullopt;
+}
+
+std::optional<TerminationMethod> parse_termination_method(
+    std::string_view name) {
+  if (name == "max_generations") {
+    return TerminationMethod::MaxGenerations;
+  } else if (name == "fitness_threshold") {
+    return TerminationMethod::FitnessThreshold;
+  }
+
+  return std::nullopt;
+}
+
+SubsetSumResult genetic_algorithm(const std::vector<int>& set,
+                                  int target,
+                                  const Objective& objective,
+                                  const GeneticOptions& options) {
+  // Dispatch once to the instantiation for this objective and operators.
+  return std::visit(
+      [&]<typename Crossover, typename Mutation, typename Termination>(
+          const auto& policy, Crossover, Mutation, Termination) {
+        return run_genetic_algorithm<std::decay_t<decltype(policy)>,
+                                     Crossover, Mutation, Termination>(
+            set, target, policy, options);
+      },
+      objective, make_crossover_policy(options.crossover_method),
+      make_mutation_policy(options.mutation_method),
+      make_termination_policy(options.termination_method));
+}
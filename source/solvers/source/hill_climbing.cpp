@@ -0,0 +1,72 @@
+#include <limits>
+#include <vector>
+
+#include "solvers.h"
+
+namespace {
+
+template <typename Objective>
+SubsetSumResult run_hill_climbing(const std::vector<int>& set,
+                                  int target,
+                                  const Objective& objective,
+                                  const HillClimbingOptions& options) {
+  std::vector<double> fitness_history;
+
+  auto mask =
+      generate_initial_solution_mask(set, target, options.seeding_method);
+  auto state = evaluate_mask(set, mask);
+  long long best_loss = loss(state, target, objective);
+
+  TelemetryStream telemetry(options.telemetry);
+  bool improved = true;
+
+  for (int step = 0; improved && step < options.max_iterations; ++step) {
+    improved = false;
+
+    // Neighbours differ by one flipped bit, so each one is evaluated in
+    // O(1) without building its mask.
+    size_t best_neighbour_index = 0;
+    long long best_neighbour_loss = std::numeric_limits<long long>::max();
+
+    for (size_t i = 0; i < mask.size(); ++i) {
+      auto curr_loss = loss(flip_state(state, set, mask, i), target, objective);
+
+      if (curr_loss < best_neighbour_loss) {
+        best_neighbour_loss = curr_loss;
+        best_neighbour_index = i;
+      }
+    }
+
+    if (best_neighbour_loss < best_loss) {
+      best_loss = best_neighbour_loss;
+      state = flip_state(state, set, mask, best_neighbour_index);
+      mask[best_neighbour_index].flip();
+      improved = true;
+    }
+
+    fitness_history.push_back(fitness(state, target, objective));
+    telemetry.push(step, best_loss);
+  }
+
+  SubsetSumResult result{
+      .best_subset = get_subset(set, mask),
+      .fitness_history = fitness_history,
+      // Hill climbing is a single iteration process
+      .iterations = 1,
+  };
+
+  return result;
+}
+
+}  // namespace
+
+SubsetSumResult hill_climbing(const std::vector<int>& set,
+                              int target,
+                              const Objective& objective,
+                              const HillClimbingOptions& options) {
+  return std::visit(
+      [&](const auto& policy) {
+        return run_hill_climbing(set, target, policy, options);
+      },
+      objective);
+}
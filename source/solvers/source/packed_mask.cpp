@@ -0,0 +1,66 @@
+#include "packed_mask.h"
+
+#include <bit>
+
+PackedMask::PackedMask(const std::vector<bool>& mask)
+    : PackedMask(mask.size()) {
+  for (size_t i = 0; i < mask.size(); ++i) {
+    if (mask[i]) {
+      flip(i);
+    }
+  }
+}
+
+std::vector<bool> PackedMask::to_vector() const {
+  std::vector<bool> mask(size_);
+  for (size_t i = 0; i < size_; ++i) {
+    mask[i] = test(i);
+  }
+  return mask;
+}
+
+SubsetState evaluate_mask(const std::vector<int>& set, const PackedMask& mask) {
+  SubsetState state;
+
+  const auto& words = mask.words();
+  for (size_t w = 0; w < words.size(); ++w) {
+    uint64_t word = words[w];
+    state.size += std::popcount(word);
+    while (word != 0) {
+      state.sum += set[w * PackedMask::WORD_BITS + std::countr_zero(word)];
+      word &= word - 1;
+    }
+  }
+
+  return state;
+}
+
+void swap_bit_range(PackedMask& mask1,
+                    PackedMask& mask2,
+                    size_t begin,
+                    size_t end) {
+  if (begin >= end) {
+    return;
+  }
+
+  auto& words1 = mask1.words();
+  auto& words2 = mask2.words();
+  size_t first = begin / PackedMask::WORD_BITS;
+  size_t last = (end - 1) / PackedMask::WORD_BITS;
+
+  for (size_t w = first; w <= last; ++w) {
+    uint64_t range = ~0ULL;
+    if (w == first) {
+      range &= ~0ULL << (begin % PackedMask::WORD_BITS);
+    }
+    if (w == last) {
+      range &= ~0ULL >> (PackedMask::WORD_BITS - 1 -
+                         (end - 1) % PackedMask::WORD_BITS);
+    }
+
+    // Swap the selected bits: t holds the bits that differ.
+    uint64_t t = (words1[w] ^ words2[w]) & range;
+    words1[w] ^= t;
+    words2[w] ^= t;
+  }
+}
@@ -0,0 +1,229 @@
+#include "selection.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+// The AVX2 tournament round is compiled as a target("avx2") clone on GCC
+// and Clang, and picked at run time, so the default build uses it on every
+// CPU that has AVX2. Other compilers only get it when building for AVX2.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TOURNAMENT_AVX2 __attribute__((target("avx2")))
+#elif defined(__AVX2__)
+#define TOURNAMENT_AVX2
+#endif
+
+#ifdef TOURNAMENT_AVX2
+#include <immintrin.h>
+#endif
+
+#include "helpers.h"
+
+namespace {
+
+/// Uniform index in [0, n) from 32 random bits (multiply-shift, no
+/// division and no rejection loop).
+uint32_t random_index(uint32_t n) {
+  return static_cast<uint32_t>(
+      (static_cast<uint64_t>(random_engine()()) * n) >> 32);
+}
+
+void random_indices(uint32_t n, std::span<uint32_t> out) {
+  for (auto& index : out) {
+    index = random_index(n);
+  }
+}
+
+/// One tournament round for the parents from `first` on: keeps the current
+/// winner unless the candidate is strictly fitter.
+void tournament_round_scalar(std::span<const double> fitness,
+                             std::span<const uint32_t> candidates,
+                             std::span<uint32_t> winners,
+                             size_t first) {
+  for (size_t i = first; i < winners.size(); ++i) {
+    uint32_t candidate = candidates[i];
+    if (fitness[candidate] > fitness[winners[i]]) {
+      winners[i] = candidate;
+    }
+  }
+}
+
+#ifdef TOURNAMENT_AVX2
+/// The same round, a gather and a blend per four lanes. Indices are
+/// gathered four at a time, the 64-bit comparison mask is packed back to
+/// 32-bit lanes to blend the indices.
+TOURNAMENT_AVX2 void tournament_round_avx2(
+    std::span<const double> fitness,
+    std::span<const uint32_t> candidates,
+    std::span<uint32_t> winners) {
+  const __m256i pack = _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0);
+  // The masked gather with an explicit source, the unmasked one trips
+  // -Wmaybe-uninitialized on GCC.
+  const __m256d zero = _mm256_setzero_pd();
+  const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+  size_t i = 0;
+  for (; i + 4 <= winners.size(); i += 4) {
+    __m128i candidate = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(candidates.data() + i));
+    __m128i winner =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(winners.data() + i));
+
+    __m256d candidate_fitness = _mm256_mask_i32gather_pd(
+        zero, fitness.data(), candidate, all, sizeof(double));
+    __m256d winner_fitness = _mm256_mask_i32gather_pd(
+        zero, fitness.data(), winner, all, sizeof(double));
+    __m256i fitter = _mm256_castpd_si256(
+        _mm256_cmp_pd(candidate_fitness, winner_fitness, _CMP_GT_OQ));
+    __m128i fitter32 =
+        _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(fitter, pack));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(winners.data() + i),
+                     _mm_blendv_epi8(winner, candidate, fitter32));
+  }
+
+  tournament_round_scalar(fitness, candidates, winners, i);
+}
+
+bool has_avx2() {
+#ifdef __GNUC__
+  static const bool supported = __builtin_cpu_supports("avx2");
+  return supported;
+#else
+  return true;
+#endif
+}
+#endif
+
+/// One tournament round for every parent.
+void tournament_round(std::span<const double> fitness,
+                      std::span<const uint32_t> candidates,
+                      std::span<uint32_t> winners) {
+#ifdef TOURNAMENT_AVX2
+  if (has_avx2()) {
+    tournament_round_avx2(fitness, candidates, winners);
+    return;
+  }
+#endif
+
+  tournament_round_scalar(fitness, candidates, winners, 0);
+}
+
+}  // namespace
+
+std::optional<SelectionMethod> parse_selection_method(std::string_view name) {
+  if (name == "tournament") {
+    return SelectionMethod::Tournament;
+  } else if (name == "roulette") {
+    return SelectionMethod::Roulette;
+  } else if (name == "sus") {
+    return SelectionMethod::StochasticUniversal;
+  }
+
+  return std::nullopt;
+}
+
+void AliasTable::build(std::span<const double> weights) {
+  size_t n = weights.size();
+  double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+
+  probability_.assign(n, 1.0);
+  alias_.resize(n);
+  std::iota(alias_.begin(), alias_.end(), 0);
+  scaled_.resize(n);
+  small_.clear();
+  large_.clear();
+
+  // Vose's method: scale the weights to an average of 1, then repeatedly
+  // fill an under-full column with mass from an over-full one.
+  for (size_t i = 0; i < n; ++i) {
+    scaled_[i] = total > 0.0 ? weights[i] * n / total : 1.0;
+    (scaled_[i] < 1.0 ? small_ : large_).push_back(i);
+  }
+
+  while (!small_.empty() && !large_.empty()) {
+    uint32_t low = small_.back();
+    small_.pop_back();
+    uint32_t high = large_.back();
+
+    probability_[low] = scaled_[low];
+    alias_[low] = high;
+
+    scaled_[high] -= 1.0 - scaled_[low];
+    if (scaled_[high] < 1.0) {
+      large_.pop_back();
+      small_.push_back(high);
+    }
+  }
+  // Whatever is left is 1 up to rounding, and keeps probability 1.
+}
+
+ParentSelector::ParentSelector(SelectionMethod method, size_t tournament_size)
+    : method_(method), tournament_size_(std::max<size_t>(tournament_size, 1)) {}
+
+void ParentSelector::select(std::span<const double> fitness,
+                            std::span<uint32_t> parents) {
+  switch (method_) {
+    case SelectionMethod::Tournament:
+      select_tournament(fitness, parents);
+      break;
+    case SelectionMethod::Roulette:
+      select_roulette(fitness, parents);
+      break;
+    case SelectionMethod::StochasticUniversal:
+      select_stochastic_universal(fitness, parents);
+      break;
+  }
+}
+
+void ParentSelector::select_tournament(std::span<const double> fitness,
+                                       std::span<uint32_t> parents) {
+  auto n = static_cast<uint32_t>(fitness.size());
+  random_indices(n, parents);
+
+  candidates_.resize(parents.size());
+  for (size_t round = 1; round < tournament_size_; ++round) {
+    random_indices(n, candidates_);
+    tournament_round(fitness, candidates_, parents);
+  }
+}
+
+void ParentSelector::select_roulette(std::span<const double> fitness,
+                                     std::span<uint32_t> parents) {
+  table_.build(fitness);
+  for (auto& parent : parents) {
+    parent = table_.sample(get_random_double(0.0, 1.0));
+  }
+}
+
+void ParentSelector::select_stochastic_universal(
+    std::span<const double> fitness,
+    std::span<uint32_t> parents) {
+  // All-zero fitness selects uniformly, like the roulette.
+  double total = std::accumulate(fitness.begin(), fitness.end(), 0.0);
+  bool uniform = !(total > 0.0);
+  auto weight = [&](size_t i) { return uniform ? 1.0 : fitness[i]; };
+  if (uniform) {
+    total = static_cast<double>(fitness.size());
+  }
+
+  // One random offset, then equally spaced pointers swept once along the
+  // running fitness sum: an individual with expected count e is picked
+  // floor(e) or ceil(e) times.
+  double step = total / parents.size();
+  double offset = get_random_double(0.0, step);
+  double cumulative = 0.0;
+  size_t index = 0;
+  for (size_t i = 0; i < parents.size(); ++i) {
+    double pointer = offset + i * step;
+    while (index + 1 < fitness.size() &&
+           cumulative + weight(index) <= pointer) {
+      cumulative += weight(index);
+      ++index;
+    }
+    parents[i] = static_cast<uint32_t>(index);
+  }
+
+  // The pointers come out in population order, shuffle them so that the
+  // pairs bred together are random.
+  std::shuffle(parents.begin(), parents.end(), random_engine());
+}
@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "helpers.h"
+#include "solvers.h"
+
+namespace {
+
+double T_linear(int i) {
+  return 1.0 / (i + 1.0);
+}
+
+double T_logarithmic(int i) {
+  return 1.0 / std::log(i + 2.0);
+}
+
+template <typename Objective>
+SubsetSumResult run_sim_annealing(const std::vector<int>& set,
+                                  int target,
+                                  const Objective& objective,
+                                  const SimAnnealingOptions& options) {
+  auto T = options.temperature_function == TemperatureFunction::Logarithmic
+               ? T_logarithmic
+               : T_linear;
+
+  std::vector<double> fitness_history;
+
+  std::vector<bool> current_mask =
+      generate_initial_solution_mask(set, target, options.seeding_method);
+  auto current_state = evaluate_mask(set, current_mask);
+  long long current_loss = loss(current_state, target, objective);
+  long long best_loss = current_loss;
+
+  TelemetryStream telemetry(options.telemetry);
+  int iterations = 0;
+  for (; iterations < options.max_iterations; ++iterations) {
+    // Generate a neighbour by flipping a random bit
+    size_t flip_index = get_random_int(0, set.size() - 1);
+    auto new_state = flip_state(current_state, set, current_mask, flip_index);
+    long long new_loss = loss(new_state, target, objective);
+
+    // Acceptance probability based on current_loss
+    double acceptance_prob =
+        std::exp((current_loss - new_loss) / T(iterations));
+
+    if (new_loss < current_loss ||
+        acceptance_prob > get_random_double(0.0, 1.0)) {
+      current_mask[flip_index].flip();
+      current_state = new_state;
+      current_loss = new_loss;
+      best_loss = std::min(best_loss, current_loss);
+    }
+
+    fitness_history.push_back(fitness(current_state, target, objective));
+    telemetry.push(iterations, best_loss);
+  }
+
+  SubsetSumResult result{
+      .best_subset = get_subset(set, current_mask),
+      .fitness_history = fitness_history,
+      .iterations = iterations,
+  };
+
+  return result;
+}
+
+}  // namespace
+
+std::optional<TemperatureFunction> parse_temperature_function(
+    std::string_view name) {
+  if (name == "linear") {
+    return TemperatureFunction::Linear;
+  } else if (name == "logarithmic") {
+    return TemperatureFunction::Logarithmic;
+  }
+
+  return std::nullopt;
+}
+
+SubsetSumResult sim_annealing(const std::vector<int>& set,
+                              int target,
+                              const Objective& objective,
+                              const SimAnnealingOptions& options) {
+  return std::visit(
+      [&](const auto& policy) {
+        return run_sim_annealing(set, target, policy, options);
+      },
+      objective);
+}
@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+#include "helpers.h"
+#include "solvers.h"
+
+namespace {
+
+template <typename Objective>
+SubsetSumResult run_tabu_search(const std::vector<int>& set,
+                                int target,
+                                const Objective& objective,
+                                const TabuSearchOptions& options) {
+  // Resuming with a different tabu list size would mix incompatible runs.
+  auto fingerprint = problem_fingerprint(
+      set, target, objective,
+      {options.max_tabu_size.value_or(std::numeric_limits<size_t>::max())});
+
+  std::vector<double> fitness_history;
+
+  std::vector<std::vector<bool>> tabu_mask_list;
+
+  int first_iteration = 0;
+  std::vector<bool> best_mask;
+  std::vector<bool> current_mask;
+  long long best_loss = 0;
+
+  std::optional<TabuCheckpoint> checkpoint;
+  if (options.checkpoint.resume) {
+    checkpoint = load_tabu_checkpoint(options.checkpoint.path);
+  }
+
+  if (checkpoint.has_value()) {
+    if (checkpoint->fingerprint != fingerprint) {
+      throw std::invalid_argument(
+          "Checkpoint is for a different problem or parameters: " +
+          options.checkpoint.path.string());
+    }
+
+    first_iteration = checkpoint->iteration + 1;
+    best_mask = std::move(checkpoint->best_mask);
+    current_mask = std::move(checkpoint->current_mask);
+    best_loss = checkpoint->best_loss;
+    tabu_mask_list = std::move(checkpoint->tabu_mask_list);
+    fitness_history = std::move(checkpoint->fitness_history);
+    load_random_state(checkpoint->random_state);
+  } else {
+    best_mask =
+        generate_initial_solution_mask(set, target, options.seeding_method);
+    current_mask = best_mask;
+    best_loss = loss(evaluate_mask(set, current_mask), target, objective);
+
+    tabu_mask_list.push_back(best_mask);
+  }
+
+  auto current_state = evaluate_mask(set, current_mask);
+
+  std::optional<CheckpointWriter> checkpoint_writer;
+  if (options.checkpoint.enabled()) {
+    checkpoint_writer.emplace(options.checkpoint.path);
+  }
+
+  TelemetryStream telemetry(options.telemetry);
+
+  for (int iteration = first_iteration; iteration < options.max_iterations;
+       ++iteration) {
+    size_t best_neighbour_index = 0;
+    long long best_neighbour_loss = std::numeric_limits<long long>::max();
+
+    // Evaluate each neighbour in O(1) and only pay for the tabu lookup
+    // when it would become the best candidate.
+    auto neighbour_mask = current_mask;
+    for (size_t i = 0; i < current_mask.size(); ++i) {
+      auto curr_loss = loss(flip_state(current_state, set, current_mask, i),
+                            target, objective);
+      if (curr_loss >= best_neighbour_loss) {
+        continue;
+      }
+
+      neighbour_mask[i].flip();
+      if (!std::ranges::contains(tabu_mask_list, neighbour_mask)) {
+        best_neighbour_index = i;
+        best_neighbour_loss = curr_loss;
+      }
+      neighbour_mask[i].flip();
+    }
+
+    if (best_neighbour_loss == std::numeric_limits<long long>::max()) {
+      break;
+    }
+
+    current_state = flip_state(current_state, set, current_mask,
+                               best_neighbour_index);
+    current_mask[best_neighbour_index].flip();
+    if (best_neighbour_loss < best_loss) {
+      best_loss = best_neighbour_loss;
+      best_mask = current_mask;
+    }
+
+    tabu_mask_list.push_back(current_mask);
+    if (options.max_tabu_size.has_value() &&
+        tabu_mask_list.size() > *options.max_tabu_size) {
+      tabu_mask_list.erase(tabu_mask_list.begin());
+    }
+
+    fitness_history.push_back(1.0 / (1 + best_loss));
+    telemetry.push(iteration, best_loss);
+
+    if (checkpoint_writer.has_value() &&
+        (iteration + 1) % options.checkpoint.interval == 0) {
+      checkpoint_writer->write(serialize_checkpoint(TabuCheckpoint{
+          .fingerprint = fingerprint,
+          .iteration = iteration,
+          .current_mask = current_mask,
+          .best_mask = best_mask,
+          .best_loss = best_loss,
+          .tabu_mask_list = tabu_mask_list,
+          .fitness_history = fitness_history,
+          .random_state = save_random_state(),
+      }));
+    }
+  }
+
+  SubsetSumResult result{
+      .best_subset = get_subset(set, best_mask),
+      .fitness_history = fitness_history,
+      .iterations = options.max_iterations,
+  };
+
+  return result;
+}
+
+}  // namespace
+
+SubsetSumResult tabu_search(const std::vector<int>& set,
+                            int target,
+                            const Objective& objective,
+                            const TabuSearchOptions& options) {
+  return std::visit(
+      [&](const auto& policy) {
+        return run_tabu_search(set, target, policy, options);
+      },
+      objective);
+}
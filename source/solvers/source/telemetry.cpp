@@ -0,0 +1,99 @@
+#include "telemetry.h"
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "helpers.h"
+
+namespace {
+
+constexpr size_t SAMPLE_CAPACITY = 4096;
+
+}  // namespace
+
+std::optional<TelemetryOptions> take_telemetry_options(int& argc,
+                                                       char* argv[]) {
+  auto destination = take_option(argc, argv, "telemetry");
+  auto interval = take_option(argc, argv, "telemetry-interval");
+
+  TelemetryOptions options;
+  if (destination.has_value()) {
+    options.destination = destination->empty() ? "stderr" : *destination;
+  }
+
+  if (interval.has_value()) {
+    if (interval->empty() || convert_type<int>(*interval) <= 0) {
+      return std::nullopt;
+    }
+    options.interval = std::chrono::milliseconds(convert_type<int>(*interval));
+  }
+
+  return options;
+}
+
+TelemetryStream::TelemetryStream(const TelemetryOptions& options)
+    : enabled_(options.enabled()),
+      interval_(options.interval),
+      start_(std::chrono::steady_clock::now()),
+      last_sample_(start_),
+      samples_(enabled_ ? SAMPLE_CAPACITY : 1) {
+  if (!enabled_) {
+    return;
+  }
+
+  if (options.destination != "stderr") {
+    file_.open(options.destination, std::ios::trunc);
+    if (!file_.is_open()) {
+      throw std::invalid_argument("Could not open telemetry file: " +
+                                  options.destination);
+    }
+  }
+
+  thread_ = std::thread([this] { run(); });
+}
+
+TelemetryStream::~TelemetryStream() {
+  if (!thread_.joinable()) {
+    return;
+  }
+
+  {
+    std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  stop_requested_.notify_one();
+  thread_.join();
+}
+
+void TelemetryStream::run() {
+  std::unique_lock lock(mutex_);
+  while (!stop_requested_.wait_for(lock, interval_,
+                                   [this] { return stopping_; })) {
+    drain();
+  }
+  drain();
+}
+
+void TelemetryStream::drain() {
+  std::ostringstream lines;
+  while (auto sample = samples_.try_pop()) {
+    lines << "{\"iteration\": " << sample->iteration
+          << ", \"best_loss\": " << sample->best_loss
+          << ", \"elapsed_ms\": " << sample->elapsed_ms << "}\n";
+  }
+
+  if (auto dropped = dropped_.exchange(0, std::memory_order_relaxed)) {
+    lines << "{\"dropped\": " << dropped << "}\n";
+  }
+
+  if (lines.view().empty()) {
+    return;
+  }
+
+  if (file_.is_open()) {
+    file_ << lines.view() << std::flush;
+  } else {
+    std::cerr << lines.view() << std::flush;
+  }
+}
@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <print>
+#include <vector>
+
+#include "helpers.h"
+#include "selection.h"
+
+namespace {
+
+int failures = 0;
+
+std::vector<double> random_fitness(size_t n, bool with_zeros) {
+  std::vector<double> fitness(n);
+  for (auto& value : fitness) {
+    value = get_random_double(0.0, 1.0);
+    value *= value * value;  // skewed, a few individuals dominate
+    if (with_zeros && get_random_double(0.0, 1.0) < 0.25) {
+      value = 0.0;
+    }
+  }
+  return fitness;
+}
+
+std::vector<double> expected_counts(const std::vector<double>& fitness,
+                                    size_t parent_count) {
+  double total = std::accumulate(fitness.begin(), fitness.end(), 0.0);
+  std::vector<double> expected(fitness.size());
+  for (size_t i = 0; i < fitness.size(); ++i) {
+    expected[i] = total > 0.0 ? fitness[i] * parent_count / total
+                              : static_cast<double>(parent_count) /
+                                    fitness.size();
+  }
+  return expected;
+}
+
+std::vector<size_t> selection_counts(ParentSelector& selector,
+                                     const std::vector<double>& fitness,
+                                     size_t parent_count) {
+  std::vector<uint32_t> parents(parent_count);
+  selector.select(fitness, parents);
+
+  std::vector<size_t> counts(fitness.size());
+  for (uint32_t parent : parents) {
+    ++counts[parent];
+  }
+  return counts;
+}
+
+/// Every individual must be picked floor(e) or ceil(e) times, in every
+/// single round.
+void check_stochastic_universal(const std::vector<double>& fitness,
+                                size_t parent_count) {
+  ParentSelector selector(SelectionMethod::StochasticUniversal);
+  auto expected = expected_counts(fitness, parent_count);
+
+  for (int round = 0; round < 200; ++round) {
+    auto counts = selection_counts(selector, fitness, parent_count);
+    for (size_t i = 0; i < fitness.size(); ++i) {
+      if (counts[i] < std::floor(expected[i] - 1e-9) ||
+          counts[i] > std::ceil(expected[i] + 1e-9)) {
+        std::print("sus: individual {} of {} picked {} times, expected {}\n",
+                   i, fitness.size(), counts[i], expected[i]);
+        ++failures;
+        return;
+      }
+    }
+  }
+}
+
+/// Summed over many rounds, the counts must be within a few standard
+/// deviations of the expected counts.
+void check_roulette(const std::vector<double>& fitness, size_t parent_count) {
+  ParentSelector selector(SelectionMethod::Roulette);
+  constexpr int ROUNDS = 2000;
+  auto expected = expected_counts(fitness, parent_count * ROUNDS);
+
+  std::vector<size_t> counts(fitness.size());
+  for (int round = 0; round < ROUNDS; ++round) {
+    auto round_counts = selection_counts(selector, fitness, parent_count);
+    for (size_t i = 0; i < fitness.size(); ++i) {
+      counts[i] += round_counts[i];
+    }
+  }
+
+  for (size_t i = 0; i < fitness.size(); ++i) {
+    double deviation = std::abs(static_cast<double>(counts[i]) - expected[i]);
+    if (deviation > 6.0 * std::sqrt(expected[i]) + 1.0) {
+      std::print("roulette: individual {} of {} picked {} times, "
+                 "expected {}\n",
+                 i, fitness.size(), counts[i], expected[i]);
+      ++failures;
+      return;
+    }
+  }
+}
+
+/// Distinct fitness, individual i has rank ranks[i] (0 is the least fit).
+std::vector<double> ranked_fitness(const std::vector<size_t>& ranks) {
+  std::vector<double> fitness(ranks.size());
+  for (size_t i = 0; i < ranks.size(); ++i) {
+    fitness[i] = 0.5 + static_cast<double>(ranks[i]);
+  }
+  return fitness;
+}
+
+/// The winner of k uniform candidates has rank r with probability
+/// ((r + 1)^k - r^k) / n^k, so a tournament that keeps the wrong candidate
+/// skews the counts towards the least fit instead.
+void check_tournament(size_t n, size_t tournament_size, size_t parent_count) {
+  std::vector<size_t> ranks(n);
+  std::iota(ranks.begin(), ranks.end(), 0);
+  std::shuffle(ranks.begin(), ranks.end(), random_engine());
+  auto fitness = ranked_fitness(ranks);
+
+  ParentSelector selector(SelectionMethod::Tournament, tournament_size);
+  constexpr int ROUNDS = 2000;
+  std::vector<uint32_t> parents(parent_count);
+  std::vector<size_t> counts(n);
+  for (int round = 0; round < ROUNDS; ++round) {
+    selector.select(fitness, parents);
+    for (uint32_t parent : parents) {
+      if (parent >= n) {
+        std::print("tournament: index {} out of {}\n", parent, n);
+        ++failures;
+        return;
+      }
+      ++counts[parent];
+    }
+  }
+
+  double k = static_cast<double>(tournament_size);
+  for (size_t i = 0; i < n; ++i) {
+    double r = static_cast<double>(ranks[i]);
+    double probability = (std::pow(r + 1, k) - std::pow(r, k)) /
+                         std::pow(static_cast<double>(n), k);
+    double expected = probability * parent_count * ROUNDS;
+    double deviation = std::abs(static_cast<double>(counts[i]) - expected);
+    if (deviation > 6.0 * std::sqrt(expected) + 1.0) {
+      std::print("tournament of {}: rank {} of {} picked {} times, "
+                 "expected {}\n",
+                 tournament_size, ranks[i], n, counts[i], expected);
+      ++failures;
+      return;
+    }
+  }
+}
+
+}  // namespace
+
+int main() {
+  // Sizes that are not a multiple of four also cover the scalar tail of
+  // the vectorized rounds.
+  for (size_t n : {1, 2, 7, 64, 1001}) {
+    for (size_t tournament_size : {1, 2, 3, 5}) {
+      check_tournament(n, tournament_size, n);
+      check_tournament(n, tournament_size, n / 2 + 3);
+    }
+  }
+
+  for (size_t n : {1, 2, 7, 64, 1000}) {
+    for (bool with_zeros : {false, true}) {
+      auto fitness = random_fitness(n, with_zeros);
+      // One parent per individual, as the genetic algorithm asks for, and
+      // fewer and more parents than individuals.
+      for (size_t parent_count : {n, n / 2 + 1, 3 * n + 1}) {
+        check_stochastic_universal(fitness, parent_count);
+        check_roulette(fitness, parent_count);
+      }
+    }
+
+    std::vector<double> zeros(n, 0.0);
+    check_stochastic_universal(zeros, n);
+    check_roulette(zeros, n);
+  }
+
+  if (failures > 0) {
+    std::print("{} selection checks failed\n", failures);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+/// Objectives are policy types evaluated from the sum and size of a subset,
+/// so solvers can update them in O(1) per flipped bit. Solvers are generic
+/// over the policy and std::visit picks the specialised instantiation once.
+///
+/// Every objective exposes:
+///  - loss(sum, size, target): 0 is optimal, lower is better
+///  - lower_bound(min_sum, max_sum, min_size, max_size, target): smallest loss
+///    reachable by any subset within the given sum and size ranges
+
+namespace objective_detail {
+
+/// Distance from a value to the closest point of [lowest, highest].
+constexpr long long distance_to_range(long long value,
+                                      long long lowest,
+                                      long long highest) {
+  if (value < lowest) {
+    return lowest - value;
+  } else if (value > highest) {
+    return value - highest;
+  }
+  return 0;
+}
+
+/// Largest loss an objective reports. Half the range, so `1 + loss` and
+/// similar arithmetic on a loss cannot overflow either.
+constexpr long long MAX_LOSS = std::numeric_limits<long long>::max() / 2;
+
+/// distance + penalty * count for non-negative operands, saturated at
+/// MAX_LOSS instead of overflowing.
+constexpr long long penalized(long long distance,
+                              long long penalty,
+                              long long count) {
+  if (distance >= MAX_LOSS) {
+    return MAX_LOSS;
+  }
+  if (count > 0 && penalty > (MAX_LOSS - distance) / count) {
+    return MAX_LOSS;
+  }
+  return distance + penalty * count;
+}
+
+}  // namespace objective_detail
+
+/// \brief Closest sum to the target: |sum - target|.
+struct AbsoluteObjective {
+  static constexpr std::string_view name = "absolute";
+
+  constexpr long long loss(long long sum, size_t, int target) const {
+    return sum > target ? sum - target : target - sum;
+  }
+
+  constexpr long long lower_bound(long long min_sum,
+                                  long long max_sum,
+                                  size_t,
+                                  size_t,
+                                  int target) const {
+    return objective_detail::distance_to_range(target, min_sum, max_sum);
+  }
+};
+
+/// \brief Closest sum not exceeding the target. Overshooting sums cost
+/// `penalty` on top of the excess, so they rank behind every feasible sum.
+struct UnderTargetObjective {
+  static constexpr std::string_view name = "under_target";
+
+  long long penalty;
+
+  constexpr long long loss(long long sum, size_t, int target) const {
+    return sum <= target ? target - sum : penalty + (sum - target);
+  }
+
+  constexpr long long lower_bound(long long min_sum,
+                                  long long max_sum,
+                                  size_t,
+                                  size_t,
+                                  int target) const {
+    if (min_sum > target) {
+      return penalty + (min_sum - target);
+    }
+    return std::max(0LL, target - max_sum);
+  }
+};
+
+/// \brief Closest sum to the target using exactly `size` elements. Every
+/// element too many or too few costs `penalty`, losses saturate at
+/// objective_detail::MAX_LOSS.
+struct CardinalityObjective {
+  static constexpr std::string_view name = "cardinality";
+
+  size_t size;
+  long long penalty;
+
+  constexpr long long loss(long long sum,
+                           size_t subset_size,
+                           int target) const {
+    long long size_diff = subset_size > size ? subset_size - size
+                                             : size - subset_size;
+    return objective_detail::penalized(
+        sum > target ? sum - target : target - sum, penalty, size_diff);
+  }
+
+  constexpr long long lower_bound(long long min_sum,
+                                  long long max_sum,
+                                  size_t min_size,
+                                  size_t max_size,
+                                  int target) const {
+    long long size_diff = objective_detail::distance_to_range(
+        static_cast<long long>(size), min_size, max_size);
+    return objective_detail::penalized(
+        objective_detail::distance_to_range(target, min_sum, max_sum),
+        penalty, size_diff);
+  }
+};
+
+using Objective =
+    std::variant<AbsoluteObjective, UnderTargetObjective, CardinalityObjective>;
+
+enum class ObjectiveKind {
+  Absolute,
+  UnderTarget,
+  Cardinality,
+};
+
+struct ObjectiveOptions {
+  ObjectiveKind kind = ObjectiveKind::Absolute;
+  size_t cardinality = 0;
+};
+
+/// \brief Takes the `--objective=absolute/under_target/cardinality` and
+/// `--cardinality=k` options. Returns std::nullopt if they are invalid.
+std::optional<ObjectiveOptions> take_objective_options(int& argc,
+                                                       char* argv[]);
+
+/// \brief Builds the objective for a set. Penalties are larger than any loss
+/// a feasible subset can have.
+Objective make_objective(const ObjectiveOptions& options,
+                         const std::vector<int>& set,
+                         int target);
+
+/// \brief Name of the objective, as printed in the result JSON.
+std::string_view objective_name(const Objective& objective);
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+enum class SeedingMethod {
+  Random,
+  Greedy,
+  Grasp,
+  Ratio,
+};
+
+/// \brief Parses a seeding method name (random/greedy/grasp/ratio).
+std::optional<SeedingMethod> parse_seeding_method(std::string_view name);
+
+/// \brief Greedy largest-first fill: walks the values in descending order and
+/// takes every value that still fits under the target.
+std::vector<bool> generate_greedy_solution_mask(const std::vector<int>& set,
+                                                int target);
+
+/// \brief Randomized greedy (GRASP) construction: like the greedy fill, but
+/// each step picks a random value from the `rcl_size` largest ones that fit.
+std::vector<bool> generate_grasp_solution_mask(const std::vector<int>& set,
+                                               int target,
+                                               size_t rcl_size = 3);
+
+/// \brief Ratio-based construction: randomly rounds the LP relaxation
+/// x_i = target / total, then greedily fills whatever gap is left.
+std::vector<bool> generate_ratio_solution_mask(const std::vector<int>& set,
+                                               int target);
+
+/// \brief Generates an initial solution mask using the given method.
+std::vector<bool> generate_initial_solution_mask(const std::vector<int>& set,
+                                                 int target,
+                                                 SeedingMethod method);
+
+/// \brief Generates an initial population. The deterministic greedy method
+/// only seeds the first individual, the rest are random to keep diversity.
+std::vector<std::vector<bool>> generate_initial_population(
+    const std::vector<int>& set,
+    int target,
+    int population_count,
+    SeedingMethod method);
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+/// \brief On-disk set formats.
+///
+/// Text: one value per line. Binary: the "SSET" magic, a uint32 version, a
+/// uint64 value count and the values as little-endian int32, a 10^8 element
+/// set loads without parsing.
+enum class SetFormat {
+  Text,
+  Binary,
+};
+
+std::optional<SetFormat> parse_set_format(std::string_view name);
+
+/// \brief Loads a set file in either format, the format is detected from the
+/// file header.
+std::vector<int> load_set(const std::filesystem::path& file);
+
+/// \brief Streams a set to a file without holding it in memory.
+class SetWriter {
+ public:
+  SetWriter(const std::filesystem::path& file, SetFormat format);
+  ~SetWriter();
+
+  SetWriter(const SetWriter&) = delete;
+  SetWriter& operator=(const SetWriter&) = delete;
+
+  void write(int value);
+
+  /// \brief Flushes the buffered values and, for binary sets, the final
+  /// count. Called by the destructor if not called before.
+  void close();
+
+ private:
+  void flush();
+
+  std::ofstream out_;
+  SetFormat format_;
+  uint64_t count_ = 0;
+  std::vector<char> buffer_;
+};
@@ -1,16 +1,59 @@
 #pragma once
 
+#include <chrono>
+#include <filesystem>
 #include <functional>
+#include <ostream>
 #include <optional>
 #include <string>
 #include <vector>
 
+#include "objective.h"
+#include "set_file.h"
+
 /// \brief Loss function for the subset sum problem.
 int loss(const std::vector<int>& subset, int target);
 
 /// \brief Fitness function for the subset sum problem.
 double fitness(const std::vector<int>& subset, int target);
 
+/// \brief Sum and size of a subset, all an objective needs to evaluate it.
+struct SubsetState {
+  long long sum = 0;
+  size_t size = 0;
+};
+
+/// \brief Evaluates the subset selected by a mask.
+SubsetState evaluate_mask(const std::vector<int>& set,
+                          const std::vector<bool>& set_mask);
+
+/// \brief Evaluates the subset after flipping one mask bit, in O(1).
+inline SubsetState flip_state(const SubsetState& state,
+                              const std::vector<int>& set,
+                              const std::vector<bool>& set_mask,
+                              size_t index) {
+  if (set_mask[index]) {
+    return {state.sum - set[index], state.size - 1};
+  }
+  return {state.sum + set[index], state.size + 1};
+}
+
+/// \brief Loss of a subset under an objective policy.
+template <typename Objective>
+long long loss(const SubsetState& state,
+               int target,
+               const Objective& objective) {
+  return objective.loss(state.sum, state.size, target);
+}
+
+/// \brief Fitness of a subset under an objective policy.
+template <typename Objective>
+double fitness(const SubsetState& state,
+               int target,
+               const Objective& objective) {
+  return 1.0 / (1 + loss(state, target, objective));
+}
+
 /// \brief Returns the subset of the set based on the mask.
 std::vector<int> get_subset(const std::vector<int>& set,
                             const std::vector<bool>& set_mask);
@@ -34,10 +77,28 @@ struct SubsetSumResult {
   std::vector<int> best_subset;
   std::vector<double> fitness_history;
   int iterations;
+  /// Proven lower bound on the best loss any subset can reach, set by
+  /// approximation schemes. loss - loss_bound bounds the error.
+  std::optional<long long> loss_bound = std::nullopt;
 };
 
+/// \brief Writes a result in the JSON shape printed by solve().
+void write_result_json(std::ostream& out,
+                       const std::string& algoritm_name,
+                       int target,
+                       const Objective& objective,
+                       const SubsetSumResult& result,
+                       std::chrono::duration<double> elapsed);
+
+/// \brief Loads the set, runs the algorithm and prints the result as JSON.
+/// The objective is built for the loaded set and handed to the algorithm.
+/// Algorithms throw std::invalid_argument for input they cannot handle,
+/// which is reported like any other invalid argument.
 void solve(const std::string& algoritm_name,
            const std::string& file,
            int target,
+           const ObjectiveOptions& objective_options,
            const std::function<SubsetSumResult(const std::vector<int>& set,
-                                               int target)>& algoritm);
+                                               int target,
+                                               const Objective& objective)>&
+               algoritm);
@@ -0,0 +1,57 @@
+#include "objective.h"
+
+#include <cstdlib>
+#include <string>
+
+#include "helpers.h"
+
+std::optional<ObjectiveOptions> take_objective_options(int& argc,
+                                                       char* argv[]) {
+  auto objective = take_option(argc, argv, "objective");
+  auto cardinality = take_option(argc, argv, "cardinality");
+
+  ObjectiveOptions options;
+  std::string name = objective.value_or("absolute");
+
+  if (name == AbsoluteObjective::name) {
+    options.kind = ObjectiveKind::Absolute;
+  } else if (name == UnderTargetObjective::name) {
+    options.kind = ObjectiveKind::UnderTarget;
+  } else if (name == CardinalityObjective::name) {
+    if (!cardinality.has_value() || cardinality->empty() ||
+        convert_type<int>(*cardinality) < 0) {
+      return std::nullopt;
+    }
+    options.kind = ObjectiveKind::Cardinality;
+    options.cardinality = convert_type<int>(*cardinality);
+  } else {
+    return std::nullopt;
+  }
+
+  return options;
+}
+
+Objective make_objective(const ObjectiveOptions& options,
+                         const std::vector<int>& set,
+                         int target) {
+  long long penalty = std::llabs(target) + 1;
+  for (int value : set) {
+    penalty += std::abs(value);
+  }
+
+  switch (options.kind) {
+    case ObjectiveKind::UnderTarget:
+      return UnderTargetObjective{.penalty = penalty};
+    case ObjectiveKind::Cardinality:
+      return CardinalityObjective{.size = options.cardinality,
+                                  .penalty = penalty};
+    case ObjectiveKind::Absolute:
+      break;
+  }
+
+  return AbsoluteObjective{};
+}
+
+std::string_view objective_name(const Objective& objective) {
+  return std::visit([](const auto& o) { return o.name; }, objective);
+}
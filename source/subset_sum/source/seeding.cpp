@@ -0,0 +1,167 @@
+#include "seeding.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "helpers.h"
+#include "subset_sum.h"
+
+namespace {
+
+/// Indices of the positive values of the set, sorted by value, descending.
+std::vector<size_t> positive_indices_descending(const std::vector<int>& set) {
+  std::vector<size_t> order;
+  for (size_t i = 0; i < set.size(); ++i) {
+    if (set[i] > 0) {
+      order.push_back(i);
+    }
+  }
+
+  std::ranges::stable_sort(order,
+                           [&](size_t a, size_t b) { return set[a] > set[b]; });
+
+  return order;
+}
+
+/// Takes every unused value (largest first) that fits into the gap.
+void greedy_fill(const std::vector<int>& set,
+                 const std::vector<size_t>& order,
+                 std::vector<bool>& mask,
+                 long long gap) {
+  for (size_t idx : order) {
+    if (gap <= 0) {
+      break;
+    }
+
+    if (!mask[idx] && set[idx] <= gap) {
+      mask[idx] = true;
+      gap -= set[idx];
+    }
+  }
+}
+
+}  // namespace
+
+std::optional<SeedingMethod> parse_seeding_method(std::string_view name) {
+  if (name == "random") {
+    return SeedingMethod::Random;
+  } else if (name == "greedy") {
+    return SeedingMethod::Greedy;
+  } else if (name == "grasp") {
+    return SeedingMethod::Grasp;
+  } else if (name == "ratio") {
+    return SeedingMethod::Ratio;
+  }
+
+  return std::nullopt;
+}
+
+std::vector<bool> generate_greedy_solution_mask(const std::vector<int>& set,
+                                                int target) {
+  std::vector<bool> mask(set.size());
+  greedy_fill(set, positive_indices_descending(set), mask, target);
+
+  return mask;
+}
+
+std::vector<bool> generate_grasp_solution_mask(const std::vector<int>& set,
+                                               int target,
+                                               size_t rcl_size) {
+  std::vector<bool> mask(set.size());
+  auto order = positive_indices_descending(set);
+
+  long long gap = target;
+  size_t first = 0;
+  std::vector<size_t> rcl;
+
+  while (gap > 0) {
+    // The gap only shrinks, so values that did not fit once never fit again.
+    while (first < order.size() &&
+           (mask[order[first]] || set[order[first]] > gap)) {
+      ++first;
+    }
+
+    rcl.clear();
+    for (size_t i = first; i < order.size() && rcl.size() < rcl_size; ++i) {
+      if (!mask[order[i]]) {
+        rcl.push_back(order[i]);
+      }
+    }
+
+    if (rcl.empty()) {
+      break;
+    }
+
+    size_t picked = rcl[get_random_int(0, static_cast<int>(rcl.size()) - 1)];
+    mask[picked] = true;
+    gap -= set[picked];
+  }
+
+  return mask;
+}
+
+std::vector<bool> generate_ratio_solution_mask(const std::vector<int>& set,
+                                               int target) {
+  std::vector<bool> mask(set.size());
+
+  long long total = 0;
+  for (int value : set) {
+    if (value > 0) {
+      total += value;
+    }
+  }
+
+  if (total == 0 || target <= 0) {
+    return mask;
+  }
+
+  double ratio = std::min(1.0, static_cast<double>(target) / total);
+
+  long long sum = 0;
+  for (size_t i = 0; i < set.size(); ++i) {
+    if (set[i] > 0 && get_random_double(0.0, 1.0) < ratio) {
+      mask[i] = true;
+      sum += set[i];
+    }
+  }
+
+  greedy_fill(set, positive_indices_descending(set), mask, target - sum);
+
+  return mask;
+}
+
+std::vector<bool> generate_initial_solution_mask(const std::vector<int>& set,
+                                                 int target,
+                                                 SeedingMethod method) {
+  switch (method) {
+    case SeedingMethod::Greedy:
+      return generate_greedy_solution_mask(set, target);
+    case SeedingMethod::Grasp:
+      return generate_grasp_solution_mask(set, target);
+    case SeedingMethod::Ratio:
+      return generate_ratio_solution_mask(set, target);
+    case SeedingMethod::Random:
+      break;
+  }
+
+  return generate_random_solution_mask(set);
+}
+
+std::vector<std::vector<bool>> generate_initial_population(
+    const std::vector<int>& set,
+    int target,
+    int population_count,
+    SeedingMethod method) {
+  std::vector<std::vector<bool>> population;
+  population.reserve(population_count);
+
+  for (int i = 0; i < population_count; ++i) {
+    if (method == SeedingMethod::Greedy && i > 0) {
+      population.push_back(generate_random_solution_mask(set));
+    } else {
+      population.push_back(generate_initial_solution_mask(set, target, method));
+    }
+  }
+
+  return population;
+}
@@ -0,0 +1,201 @@
+#include "set_file.h"
+
+#include <bit>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+constexpr char MAGIC[4] = {'S', 'S', 'E', 'T'};
+constexpr uint32_t VERSION = 1;
+constexpr size_t HEADER_SIZE =
+    sizeof(MAGIC) + sizeof(uint32_t) + sizeof(uint64_t);
+constexpr size_t BUFFER_SIZE = 1 << 20;
+
+static_assert(std::endian::native == std::endian::little,
+              "Binary sets are stored little-endian");
+
+/// Appends the values in [current, end), which must not cut a value.
+void parse_text_values(const char* current,
+                       const char* end,
+                       std::vector<int>& set,
+                       const std::filesystem::path& file) {
+  while (true) {
+    while (current != end &&
+           std::isspace(static_cast<unsigned char>(*current))) {
+      ++current;
+    }
+    if (current == end) {
+      break;
+    }
+
+    int value;
+    auto [next, error] = std::from_chars(current, end, value);
+    if (error != std::errc()) {
+      throw std::runtime_error("Invalid set value in " + file.string());
+    }
+
+    set.push_back(value);
+    current = next;
+  }
+}
+
+/// Parses the text in fixed-size chunks, so only the values are held in
+/// memory and not the whole file. A value cut at the end of a chunk is
+/// carried over to the next one.
+std::vector<int> read_text_set(std::ifstream& in,
+                               const std::filesystem::path& file) {
+  std::vector<int> set;
+  std::string buffer(BUFFER_SIZE, '\0');
+  size_t carry = 0;
+
+  while (true) {
+    in.read(buffer.data() + carry, buffer.size() - carry);
+    size_t size = carry + static_cast<size_t>(in.gcount());
+    bool last = !in;
+
+    size_t parse_end = size;
+    if (!last) {
+      while (parse_end > 0 &&
+             !std::isspace(static_cast<unsigned char>(buffer[parse_end - 1]))) {
+        --parse_end;
+      }
+      if (parse_end == 0) {
+        throw std::runtime_error("Invalid set value in " + file.string());
+      }
+    }
+
+    parse_text_values(buffer.data(), buffer.data() + parse_end, set, file);
+    if (last) {
+      break;
+    }
+
+    carry = size - parse_end;
+    std::memmove(buffer.data(), buffer.data() + parse_end, carry);
+  }
+
+  return set;
+}
+
+/// Reads the values straight into the set, after the header.
+std::vector<int> read_binary_set(std::ifstream& in,
+                                 const char* header,
+                                 const std::filesystem::path& file) {
+  uint32_t version;
+  uint64_t count;
+  std::memcpy(&version, header + sizeof(MAGIC), sizeof(version));
+  std::memcpy(&count, header + sizeof(MAGIC) + sizeof(version),
+              sizeof(count));
+
+  auto payload = std::filesystem::file_size(file) - HEADER_SIZE;
+  if (version != VERSION || payload / sizeof(int32_t) != count) {
+    throw std::runtime_error("Invalid binary set: " + file.string());
+  }
+
+  std::vector<int> set(count);
+  in.read(reinterpret_cast<char*>(set.data()), count * sizeof(int32_t));
+  if (!in) {
+    throw std::runtime_error("Invalid binary set: " + file.string());
+  }
+
+  return set;
+}
+
+}  // namespace
+
+std::optional<SetFormat> parse_set_format(std::string_view name) {
+  if (name == "text") {
+    return SetFormat::Text;
+  } else if (name == "binary") {
+    return SetFormat::Binary;
+  }
+
+  return std::nullopt;
+}
+
+std::vector<int> load_set(const std::filesystem::path& file) {
+  std::ifstream in(file, std::ios::binary);
+  if (!in.is_open()) {
+    throw std::runtime_error("Could not open file: " + file.string());
+  }
+
+  char header[HEADER_SIZE];
+  in.read(header, sizeof(header));
+  if (in.gcount() == sizeof(header) &&
+      std::memcmp(header, MAGIC, sizeof(MAGIC)) == 0) {
+    return read_binary_set(in, header, file);
+  }
+
+  in.clear();
+  in.seekg(0);
+  return read_text_set(in, file);
+}
+
+SetWriter::SetWriter(const std::filesystem::path& file, SetFormat format)
+    : out_(file, std::ios::binary | std::ios::trunc), format_(format) {
+  if (!out_.is_open()) {
+    throw std::runtime_error("Could not open file: " + file.string());
+  }
+
+  buffer_.reserve(BUFFER_SIZE);
+
+  if (format_ == SetFormat::Binary) {
+    // The count is patched in by close().
+    out_.write(MAGIC, sizeof(MAGIC));
+    out_.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+    out_.write(reinterpret_cast<const char*>(&count_), sizeof(count_));
+  }
+}
+
+SetWriter::~SetWriter() {
+  if (!out_.is_open()) {
+    return;
+  }
+
+  try {
+    close();
+  } catch (const std::exception&) {
+    // Destructors must not throw, call close() to see write errors.
+  }
+}
+
+void SetWriter::write(int value) {
+  if (buffer_.size() + 16 > BUFFER_SIZE) {
+    flush();
+  }
+
+  if (format_ == SetFormat::Binary) {
+    auto value32 = static_cast<int32_t>(value);
+    auto bytes = reinterpret_cast<const char*>(&value32);
+    buffer_.insert(buffer_.end(), bytes, bytes + sizeof(value32));
+  } else {
+    char text[16];
+    auto [end, error] = std::to_chars(text, text + sizeof(text) - 1, value);
+    *end++ = '\n';
+    buffer_.insert(buffer_.end(), text, end);
+  }
+
+  ++count_;
+}
+
+void SetWriter::close() {
+  flush();
+
+  if (format_ == SetFormat::Binary) {
+    out_.seekp(sizeof(MAGIC) + sizeof(VERSION));
+    out_.write(reinterpret_cast<const char*>(&count_), sizeof(count_));
+  }
+
+  out_.close();
+  if (out_.fail()) {
+    throw std::runtime_error("Could not write set file");
+  }
+}
+
+void SetWriter::flush() {
+  out_.write(buffer_.data(), buffer_.size());
+  buffer_.clear();
+}
@@ -1,8 +1,11 @@
 #include "subset_sum.h"
 
+#include <cstdlib>
 #include <iostream>
 #include <numeric>
+#include <print>
 #include <random>
+#include <stdexcept>
 
 #include "helpers.h"
 
@@ -18,6 +21,20 @@ double fitness(const std::vector<int>& subset, int target) {
   return 1.0 / (1 + std::abs(sum - target));
 }
 
+SubsetState evaluate_mask(const std::vector<int>& set,
+                          const std::vector<bool>& set_mask) {
+  SubsetState state;
+
+  for (size_t i = 0; i < set.size(); ++i) {
+    if (set_mask[i]) {
+      state.sum += set[i];
+      ++state.size;
+    }
+  }
+
+  return state;
+}
+
 std::vector<int> get_subset(const std::vector<int>& set,
                             const std::vector<bool>& set_mask) {
   std::vector<int> subset;
@@ -72,48 +89,70 @@ std::vector<bool> generate_random_solution_mask(const std::vector<int>& set) {
   return mask;
 }
 
+void write_result_json(std::ostream& out,
+                       const std::string& algoritm_name,
+                       int target,
+                       const Objective& objective,
+                       const SubsetSumResult& result,
+                       std::chrono::duration<double> elapsed) {
+  long long final_value = std::accumulate(result.best_subset.begin(),
+                                          result.best_subset.end(), 0LL);
+  SubsetState final_state{final_value, result.best_subset.size()};
+  long long loss_value = std::visit(
+      [&](const auto& o) { return loss(final_state, target, o); }, objective);
+
+  out << "{\n";
+  out << "  \"algorithm\": \"" << algoritm_name << "\",\n";
+  out << "  \"objective\": \"" << objective_name(objective) << "\",\n";
+  out << "  \"time_ms\": " << (elapsed.count() * 1000) << ",\n";
+  out << "  \"iterations\": " << result.iterations << ",\n";
+  out << "  \"best_subset\": [";
+  for (size_t i = 0; i < result.best_subset.size(); ++i) {
+    out << result.best_subset[i];
+    if (i + 1 < result.best_subset.size())
+      out << ", ";
+  }
+  out << "],\n";
+  out << "  \"fitness_history\": [";
+  for (size_t i = 0; i < result.fitness_history.size(); ++i) {
+    out << result.fitness_history[i];
+    if (i + 1 < result.fitness_history.size())
+      out << ", ";
+  }
+  out << "],\n";
+  out << "  \"subset_size\": " << result.best_subset.size() << ",\n";
+  out << "  \"final_value\": " << final_value << ",\n";
+  out << "  \"target\": " << target << ",\n";
+  out << "  \"loss\": " << loss_value;
+  if (result.loss_bound.has_value()) {
+    out << ",\n  \"loss_bound\": " << *result.loss_bound;
+  }
+  out << "\n";
+  out << "}\n";
+}
+
 void solve(const std::string& algoritm_name,
            const std::string& file,
            int target,
+           const ObjectiveOptions& objective_options,
            const std::function<SubsetSumResult(const std::vector<int>& set,
-                                               int target)>& algoritm) {
-  auto setFile = read_file(file);
-  std::vector<int> set;
-  for (const auto& line : setFile) {
-    set.push_back(std::stoi(line));
-  }
+                                               int target,
+                                               const Objective& objective)>&
+               algoritm) {
+  auto set = load_set(file);
+  auto objective = make_objective(objective_options, set, target);
 
   // Measure time
   auto start = std::chrono::high_resolution_clock::now();
-  SubsetSumResult result = algoritm(set, target);
+  SubsetSumResult result;
+  try {
+    result = algoritm(set, target, objective);
+  } catch (const std::invalid_argument& e) {
+    std::print("Invalid input: {}\n", e.what());
+    std::exit(1);
+  }
   auto end = std::chrono::high_resolution_clock::now();
 
-  std::chrono::duration<double> elapsed = end - start;
-  int final_value =
-      std::accumulate(result.best_subset.begin(), result.best_subset.end(), 0);
-  int loss_value = loss(result.best_subset, target);
-
-  std::cout << "{\n";
-  std::cout << "  \"algorithm\": \"" << algoritm_name << "\",\n";
-  std::cout << "  \"time_ms\": " << (elapsed.count() * 1000) << ",\n";
-  std::cout << "  \"iterations\": " << result.iterations << ",\n";
-  std::cout << "  \"best_subset\": [";
-  for (size_t i = 0; i < result.best_subset.size(); ++i) {
-    std::cout << result.best_subset[i];
-    if (i + 1 < result.best_subset.size())
-      std::cout << ", ";
-  }
-  std::cout << "],\n";
-  std::cout << "  \"fitness_history\": [";
-  for (size_t i = 0; i < result.fitness_history.size(); ++i) {
-    std::cout << result.fitness_history[i];
-    if (i + 1 < result.fitness_history.size())
-      std::cout << ", ";
-  }
-  std::cout << "],\n";
-  std::cout << "  \"subset_size\": " << result.best_subset.size() << ",\n";
-  std::cout << "  \"final_value\": " << final_value << ",\n";
-  std::cout << "  \"target\": " << target << ",\n";
-  std::cout << "  \"loss\": " << loss_value << "\n";
-  std::cout << "}\n";
+  write_result_json(std::cout, algoritm_name, target, objective, result,
+                    end - start);
 }
@@ -0,0 +1,38 @@
+#include <print>
+#include <vector>
+
+#include "helpers.h"
+#include "solvers.h"
+#include "subset_sum.h"
+
+int main(int argc, char* argv[]) {
+  size_t thread_count = take_thread_count(argc, argv);
+  auto objective_options = take_objective_options(argc, argv);
+  auto telemetry_options = take_telemetry_options(argc, argv);
+  auto [file, target] = parse_args<std::string, int>(
+      argc, argv,
+      "<file> <target> [--threads=N] "
+      "[--objective=absolute/under_target/cardinality] [--cardinality=k] "
+      "[--telemetry[=stderr/path]] [--telemetry-interval=ms]");
+
+  if (!objective_options.has_value()) {
+    std::print("Invalid objective\n");
+    return 1;
+  }
+
+  if (!telemetry_options.has_value()) {
+    std::print("Invalid telemetry options\n");
+    return 1;
+  }
+
+  BranchAndBoundOptions options{
+      .thread_count = thread_count,
+      .telemetry = *telemetry_options,
+  };
+
+  solve("Branch and bound", file, target, *objective_options,
+        [&](const std::vector<int>& set, int target,
+            const Objective& objective) {
+          return branch_and_bound(set, target, objective, options);
+        });
+}
@@ -0,0 +1,52 @@
+#include <print>
+#include <vector>
+
+#include "helpers.h"
+#include "solvers.h"
+#include "subset_sum.h"
+
+int main(int argc, char* argv[]) {
+  size_t thread_count = take_thread_count(argc, argv);
+  auto memory_str = take_option(argc, argv, "memory");
+  auto objective_options = take_objective_options(argc, argv);
+  auto telemetry_options = take_telemetry_options(argc, argv);
+  auto [file, target, epsilon] = parse_args<std::string, int, double>(
+      argc, argv,
+      "<file> <target> <epsilon> [--threads=N] [--memory=MiB] "
+      "[--objective=absolute/under_target] "
+      "[--telemetry[=stderr/path]] [--telemetry-interval=ms]");
+
+  if (!(epsilon > 0.0)) {
+    std::print("Invalid epsilon: {}\n", epsilon);
+    return 1;
+  }
+
+  int memory_mib = convert_type<int>(memory_str.value_or("1024"));
+  if (memory_mib <= 0) {
+    std::print("Invalid memory limit: {}\n", *memory_str);
+    return 1;
+  }
+
+  if (!objective_options.has_value()) {
+    std::print("Invalid objective\n");
+    return 1;
+  }
+
+  if (!telemetry_options.has_value()) {
+    std::print("Invalid telemetry options\n");
+    return 1;
+  }
+
+  FptasOptions options{
+      .epsilon = epsilon,
+      .thread_count = thread_count,
+      .memory_limit = static_cast<size_t>(memory_mib) << 20,
+      .telemetry = *telemetry_options,
+  };
+
+  solve("FPTAS", file, target, *objective_options,
+        [&](const std::vector<int>& set, int target,
+            const Objective& objective) {
+          return fptas(set, target, objective, options);
+        });
+}
@@ -1,55 +1,38 @@
-#include <chrono>
-#include <numeric>
 #include <print>
 #include <vector>
 
 #include "helpers.h"
+#include "solvers.h"
 #include "subset_sum.h"
 
 int main(int argc, char* argv[]) {
-  auto [file, target] =
-      parse_args<std::string, int>(argc, argv, "<file> <target>");
-
-  solve("Full search", file, target,
-        [&](const std::vector<int>& set, int target) {
-          std::vector<double> fitness_history;
-
-          std::vector<bool> best_mask;
-          int best_loss = target;
-
-          // Generate all possible masks
-          std::vector<std::vector<bool>> masks;
-
-          // Generate all masks (2^set_size)
-          uint64_t all_combinations = 1ULL << set.size();
-
-          for (uint64_t i = 0; i < all_combinations; ++i) {
-            std::vector<bool> mask(set.size());
-            for (int j = 0; j < set.size(); ++j) {
-              mask[j] = (i & (1ULL << j)) != 0;
-            }
-            masks.push_back(mask);
-          }
-
-          // Evaluate all masks
-          for (const auto& mask : masks) {
-            auto subset = get_subset(set, mask);
-            auto curr_loss = loss(subset, target);
-
-            if (curr_loss < best_loss) {
-              best_loss = curr_loss;
-              best_mask = mask;
-
-              fitness_history.push_back(fitness(subset, target));
-            }
-          }
-
-          SubsetSumResult result{
-              .best_subset = get_subset(set, best_mask),
-              .fitness_history = fitness_history,
-              .iterations = static_cast<int>(masks.size()),
-          };
-
-          return result;
+  size_t thread_count = take_thread_count(argc, argv);
+  auto objective_options = take_objective_options(argc, argv);
+  auto telemetry_options = take_telemetry_options(argc, argv);
+  auto [file, target] = parse_args<std::string, int>(
+      argc, argv,
+      "<file> <target> [--threads=N] "
+      "[--objective=absolute/under_target/cardinality] [--cardinality=k] "
+      "[--telemetry[=stderr/path]] [--telemetry-interval=ms]");
+
+  if (!objective_options.has_value()) {
+    std::print("Invalid objective\n");
+    return 1;
+  }
+
+  if (!telemetry_options.has_value()) {
+    std::print("Invalid telemetry options\n");
+    return 1;
+  }
+
+  FullSearchOptions options{
+      .thread_count = thread_count,
+      .telemetry = *telemetry_options,
+  };
+
+  solve("Full search", file, target, *objective_options,
+        [&](const std::vector<int>& set, int target,
+            const Objective& objective) {
+          return full_search(set, target, objective, options);
         });
 }
@@ -0,0 +1,218 @@
+// Generates reproducible synthetic sets for benchmarking.
+//
+//   uniform    values drawn uniformly from [1, max_value]
+//   skewed     power law, most values are small and a few are large
+//   clustered  values spread around a few random centres
+//   planted    uniform values, the target is the sum of a hidden random
+//              subset, so the optimum (loss 0) is known
+//
+// The same seed always gives the same set: the generator uses its own
+// SplitMix64 stream instead of the implementation defined <random>
+// distributions. Values are streamed to the file, so 10^8 element sets do
+// not need to fit in memory. A JSON summary (with the target for planted
+// sets) is printed to stdout.
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <print>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "helpers.h"
+#include "set_file.h"
+
+namespace {
+
+enum class Distribution {
+  Uniform,
+  Skewed,
+  Clustered,
+  Planted,
+};
+
+std::optional<Distribution> parse_distribution(std::string_view name) {
+  if (name == "uniform") {
+    return Distribution::Uniform;
+  } else if (name == "skewed") {
+    return Distribution::Skewed;
+  } else if (name == "clustered") {
+    return Distribution::Clustered;
+  } else if (name == "planted") {
+    return Distribution::Planted;
+  }
+
+  return std::nullopt;
+}
+
+class SplitMix64 {
+ public:
+  explicit SplitMix64(uint64_t seed) : state_(seed) {}
+
+  uint64_t next() {
+    uint64_t z = (state_ += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  /// Uniform in [0, 1).
+  double next_double() { return (next() >> 11) * 0x1.0p-53; }
+
+  /// Uniform in [min, max].
+  int next_int(int min, int max) {
+    uint64_t range = static_cast<uint64_t>(max) - min + 1;
+    return static_cast<int>(min + next() % range);
+  }
+
+ private:
+  uint64_t state_;
+};
+
+/// Picks `count` distinct positions out of [0, n) in ascending order
+/// (Floyd's algorithm, O(count) expected).
+std::vector<uint64_t> sample_positions(SplitMix64& rng,
+                                       uint64_t n,
+                                       uint64_t count) {
+  std::unordered_set<uint64_t> taken;
+  taken.reserve(count);
+  std::vector<uint64_t> positions;
+  for (uint64_t j = n - count; j < n; ++j) {
+    uint64_t t = rng.next() % (j + 1);
+    uint64_t position = taken.contains(t) ? j : t;
+    taken.insert(position);
+    positions.push_back(position);
+  }
+
+  std::ranges::sort(positions);
+  return positions;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  auto seed_str = take_option(argc, argv, "seed");
+  auto format_str = take_option(argc, argv, "format");
+  auto max_value_str = take_option(argc, argv, "max-value");
+  auto clusters_str = take_option(argc, argv, "clusters");
+  auto planted_size_str = take_option(argc, argv, "planted-size");
+  auto [file, count, distribution_str] =
+      parse_args<std::string, int, std::string>(
+          argc, argv,
+          "<output_file> <count> "
+          "<distribution: uniform/skewed/clustered/planted> "
+          "[--seed=N] [--format=text/binary] [--max-value=V] "
+          "[--clusters=K] [--planted-size=K]");
+
+  auto distribution = parse_distribution(distribution_str);
+  if (!distribution.has_value()) {
+    std::print("Invalid distribution: {}\n", distribution_str);
+    return 1;
+  }
+
+  auto format = parse_set_format(format_str.value_or("text"));
+  if (!format.has_value()) {
+    std::print("Invalid format: {}\n", *format_str);
+    return 1;
+  }
+
+  if (count <= 0) {
+    std::print("Invalid count: {}\n", count);
+    return 1;
+  }
+
+  int seed = convert_type<int>(seed_str.value_or("1"));
+  int max_value = convert_type<int>(max_value_str.value_or("1000000"));
+  int cluster_count = convert_type<int>(clusters_str.value_or("8"));
+  int planted_size = convert_type<int>(planted_size_str.value_or("32"));
+
+  if (max_value <= 0) {
+    std::print("Invalid max value: {}\n", max_value);
+    return 1;
+  }
+
+  if (cluster_count <= 0) {
+    std::print("Invalid cluster count: {}\n", cluster_count);
+    return 1;
+  }
+
+  // The target of a planted set has to fit the solvers' int target.
+  if (*distribution == Distribution::Planted &&
+      (planted_size <= 0 || planted_size > count ||
+       static_cast<long long>(planted_size) * max_value > INT_MAX)) {
+    std::print("Invalid planted size: {}\n", planted_size);
+    return 1;
+  }
+
+  SplitMix64 rng(static_cast<uint64_t>(seed));
+
+  std::vector<int> centres;
+  int spread = std::max(max_value / (4 * cluster_count), 1);
+  if (*distribution == Distribution::Clustered) {
+    for (int i = 0; i < cluster_count; ++i) {
+      centres.push_back(rng.next_int(1, max_value));
+    }
+  }
+
+  std::vector<uint64_t> planted;
+  if (*distribution == Distribution::Planted) {
+    planted = sample_positions(rng, count, planted_size);
+  }
+
+  auto next_value = [&]() {
+    switch (*distribution) {
+      case Distribution::Skewed: {
+        double u = rng.next_double();
+        return 1 + static_cast<int>((max_value - 1) * u * u * u * u);
+      }
+      case Distribution::Clustered: {
+        // A sum of three uniforms is a cheap bell curve around the centre.
+        int centre = centres[rng.next() % centres.size()];
+        double offset =
+            rng.next_double() + rng.next_double() + rng.next_double() - 1.5;
+        int value = centre + static_cast<int>(std::lround(offset * spread));
+        return std::clamp(value, 1, max_value);
+      }
+      case Distribution::Uniform:
+      case Distribution::Planted:
+        break;
+    }
+
+    return rng.next_int(1, max_value);
+  };
+
+  SetWriter writer(file, *format);
+  long long sum = 0;
+  long long target = 0;
+  size_t next_planted = 0;
+
+  for (uint64_t i = 0; i < static_cast<uint64_t>(count); ++i) {
+    int value = next_value();
+    writer.write(value);
+    sum += value;
+
+    if (next_planted < planted.size() && planted[next_planted] == i) {
+      target += value;
+      ++next_planted;
+    }
+  }
+  writer.close();
+
+  std::cout << "{\n";
+  std::cout << "  \"file\": \"" << file << "\",\n";
+  std::cout << "  \"distribution\": \"" << distribution_str << "\",\n";
+  std::cout << "  \"format\": \"" << format_str.value_or("text") << "\",\n";
+  std::cout << "  \"count\": " << count << ",\n";
+  std::cout << "  \"seed\": " << seed << ",\n";
+  std::cout << "  \"sum\": " << sum;
+  if (*distribution == Distribution::Planted) {
+    std::cout << ",\n  \"planted_size\": " << planted_size << ",\n";
+    std::cout << "  \"target\": " << target;
+  }
+  std::cout << "\n}\n";
+}
@@ -0,0 +1,624 @@
+// Long-running solver service. Listens on a Unix domain socket and answers
+// one request per line:
+//
+//   <set_file> <target> <algorithm> <budget> [--option=value ...]
+//
+// with the same JSON solve() prints. The budget caps the iterations (or
+// generations) of the heuristics, 0 keeps the solver default. Options are
+// the ones the solver executables take (--objective, --seeding, --threads,
+// --selection, --memory, ...) plus --epsilon, --temperature, --tabu-size,
+// --population, --crossover, --mutation and --termination for the
+// positional arguments.
+//
+// Idle connections hold no worker, only complete request lines are run on
+// the pool. The server's --threads is a budget shared by all running
+// requests: a request gets as many of the threads it asks for as are free,
+// at least one, so the solvers never run more threads than that in total.
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <print>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "helpers.h"
+#include "solvers.h"
+#include "subset_sum.h"
+#include "thread_pool.h"
+
+/// \brief LRU cache of parsed sets, keyed by path. An entry is reloaded when
+/// the file modification time changed since it was parsed.
+class SetCache {
+ public:
+  explicit SetCache(size_t capacity) : capacity_(capacity) {}
+
+  std::shared_ptr<const std::vector<int>> get(
+      const std::filesystem::path& path) {
+    auto key = std::filesystem::absolute(path).string();
+    auto mtime = std::filesystem::last_write_time(path);
+
+    {
+      std::lock_guard lock(mutex_);
+      auto it = entries_.find(key);
+      if (it != entries_.end() && it->second->mtime == mtime) {
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return it->second->set;
+      }
+    }
+
+    // Parse outside the lock, so a large set does not stall other requests.
+    auto set = std::make_shared<const std::vector<int>>(load_set(path));
+
+    std::lock_guard lock(mutex_);
+    if (auto it = entries_.find(key); it != entries_.end()) {
+      lru_.erase(it->second);
+      entries_.erase(it);
+    }
+
+    lru_.push_front({key, mtime, set});
+    entries_[key] = lru_.begin();
+
+    while (lru_.size() > capacity_) {
+      entries_.erase(lru_.back().key);
+      lru_.pop_back();
+    }
+
+    return set;
+  }
+
+ private:
+  struct Entry {
+    std::string key;
+    std::filesystem::file_time_type mtime;
+    std::shared_ptr<const std::vector<int>> set;
+  };
+
+  size_t capacity_;
+  std::mutex mutex_;
+  std::list<Entry> lru_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> entries_;
+};
+
+/// \brief Parses a single request option, throwing on invalid values.
+template <typename T>
+T parse_option(std::optional<T> value, std::string_view what) {
+  if (!value.has_value()) {
+    throw std::invalid_argument("Invalid " + std::string(what));
+  }
+  return *value;
+}
+
+/// \brief Parses a whole string as a count of at least `min`, std::nullopt
+/// if it is anything else.
+std::optional<size_t> parse_count(std::string_view value, size_t min) {
+  size_t count;
+  auto [end, error] =
+      std::from_chars(value.data(), value.data() + value.size(), count);
+  if (error != std::errc() || end != value.data() + value.size() ||
+      count < min) {
+    return std::nullopt;
+  }
+  return count;
+}
+
+/// \brief Solver threads shared by all running requests. A request takes
+/// as many of the threads it asks for as are free, and waits while none
+/// are, so the requests never run more threads than the budget together.
+class ThreadBudget {
+ public:
+  explicit ThreadBudget(size_t threads) : free_(threads) {}
+
+  /// \brief Threads taken by one request, given back on destruction.
+  class Lease {
+   public:
+    Lease(ThreadBudget& budget, size_t wanted)
+        : budget_(budget), count_(budget.acquire(wanted)) {}
+    ~Lease() { budget_.release(count_); }
+
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+
+    size_t count() const { return count_; }
+
+   private:
+    ThreadBudget& budget_;
+    size_t count_;
+  };
+
+ private:
+  size_t acquire(size_t wanted) {
+    std::unique_lock lock(mutex_);
+    released_.wait(lock, [this] { return free_ > 0; });
+    size_t count = std::clamp<size_t>(wanted, 1, free_);
+    free_ -= count;
+    return count;
+  }
+
+  void release(size_t count) {
+    {
+      std::lock_guard lock(mutex_);
+      free_ += count;
+    }
+    released_.notify_all();
+  }
+
+  size_t free_;
+  std::mutex mutex_;
+  std::condition_variable released_;
+};
+
+/// \brief Runs one request on threads leased from `thread_budget`. Every
+/// request holds at least one, the thread running a single-threaded solver.
+std::string handle_request(const std::string& line,
+                           SetCache& cache,
+                           ThreadBudget& thread_budget) {
+  std::istringstream stream(line);
+  std::vector<std::string> tokens;
+  for (std::string token; stream >> token;) {
+    tokens.push_back(token);
+  }
+
+  if (tokens.size() < 4) {
+    throw std::invalid_argument(
+        "Expected: <set_file> <target> <algorithm> <budget> [--option=value]");
+  }
+
+  // Reuse the command line option helpers on the trailing tokens.
+  std::vector<char*> argv = {nullptr};
+  for (size_t i = 4; i < tokens.size(); ++i) {
+    argv.push_back(tokens[i].data());
+  }
+  int argc = static_cast<int>(argv.size());
+
+  auto target = convert_type<int>(tokens[1]);
+  const auto& algorithm = tokens[2];
+  auto budget = convert_type<int>(tokens[3]);
+
+  auto seeding_method = parse_option(
+      parse_seeding_method(
+          take_option(argc, argv.data(), "seeding").value_or("random")),
+      "seeding method");
+  auto objective_options =
+      parse_option(take_objective_options(argc, argv.data()), "objective");
+  auto threads = take_option(argc, argv.data(), "threads");
+  size_t wanted_threads =
+      threads ? parse_option(parse_count(*threads, 1), "thread count") : 1;
+
+  auto set = cache.get(tokens[0]);
+  auto objective = make_objective(objective_options, *set, target);
+
+  // Taken after the set is loaded, so parsing a set holds no solver threads.
+  ThreadBudget::Lease lease(thread_budget, wanted_threads);
+  size_t thread_count = lease.count();
+
+  std::string name;
+  std::function<SubsetSumResult()> run;
+
+  if (algorithm == "full_search") {
+    name = "Full search";
+    run = [&] {
+      return full_search(*set, target, objective,
+                         {.thread_count = thread_count});
+    };
+  } else if (algorithm == "branch_and_bound") {
+    name = "Branch and bound";
+    run = [&] {
+      return branch_and_bound(*set, target, objective,
+                              {.thread_count = thread_count});
+    };
+  } else if (algorithm == "fptas") {
+    FptasOptions options{
+        .epsilon = convert_type<double>(
+            take_option(argc, argv.data(), "epsilon").value_or("0.1")),
+        .thread_count = thread_count,
+    };
+    if (auto memory = take_option(argc, argv.data(), "memory")) {
+      options.memory_limit =
+          static_cast<size_t>(std::max(convert_type<int>(*memory), 1)) << 20;
+    }
+    name = "FPTAS";
+    run = [&, options] { return fptas(*set, target, objective, options); };
+  } else if (algorithm == "hill_climbing") {
+    HillClimbingOptions options{.seeding_method = seeding_method};
+    if (budget > 0) {
+      options.max_iterations = budget;
+    }
+    name = "Hill climbing";
+    run = [&, options] {
+      return hill_climbing(*set, target, objective, options);
+    };
+  } else if (algorithm == "sim_annealing") {
+    SimAnnealingOptions options{
+        .temperature_function = parse_option(
+            parse_temperature_function(
+                take_option(argc, argv.data(), "temperature")
+                    .value_or("linear")),
+            "temperature function"),
+        .seeding_method = seeding_method,
+    };
+    if (budget > 0) {
+      options.max_iterations = budget;
+    }
+    name = "Simulated annealing";
+    run = [&, options] {
+      return sim_annealing(*set, target, objective, options);
+    };
+  } else if (algorithm == "tabu_search") {
+    TabuSearchOptions options{.seeding_method = seeding_method};
+    if (auto size = take_option(argc, argv.data(), "tabu-size")) {
+      options.max_tabu_size = convert_type<int>(*size);
+    }
+    if (budget > 0) {
+      options.max_iterations = budget;
+    }
+    name = "Tabu search";
+    run = [&, options] {
+      return tabu_search(*set, target, objective, options);
+    };
+  } else if (algorithm == "genetic_algorithm" ||
+             algorithm == "genetic_algorithm_parallel") {
+    GeneticOptions options{
+        .population_count = convert_type<int>(
+            take_option(argc, argv.data(), "population").value_or("100")),
+        .crossover_method = parse_option(
+            parse_crossover_method(take_option(argc, argv.data(), "crossover")
+                                       .value_or("two_point")),
+            "crossover method"),
+        .mutation_method = parse_option(
+            parse_mutation_method(take_option(argc, argv.data(), "mutation")
+                                      .value_or("single_bit_flip")),
+            "mutation method"),
+        .termination_method = parse_option(
+            parse_termination_method(
+                take_option(argc, argv.data(), "termination")
+                    .value_or("max_generations")),
+            "termination method"),
+        .seeding_method = seeding_method,
+        .selection_method = parse_option(
+            parse_selection_method(take_option(argc, argv.data(), "selection")
+                                       .value_or("tournament")),
+            "selection method"),
+        .parallel = algorithm == "genetic_algorithm_parallel",
+        .thread_count = thread_count,
+    };
+    if (budget > 0) {
+      options.max_generations = budget;
+      options.generation_budget = budget;
+    }
+    name = options.parallel ? "Genetic parallel" : "Genetic";
+    run = [&, options] {
+      return genetic_algorithm(*set, target, objective, options);
+    };
+  } else {
+    throw std::invalid_argument("Unknown algorithm: " + algorithm);
+  }
+
+  if (argc > 1) {
+    throw std::invalid_argument("Unknown option: " + std::string(argv[1]));
+  }
+
+  auto start = std::chrono::high_resolution_clock::now();
+  SubsetSumResult result = run();
+  auto end = std::chrono::high_resolution_clock::now();
+
+  std::ostringstream out;
+  write_result_json(out, name, target, objective, result, end - start);
+  return out.str();
+}
+
+std::string error_json(std::string_view message) {
+  std::string escaped;
+  for (char c : message) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return "{\n  \"error\": \"" + escaped + "\"\n}\n";
+}
+
+bool write_all(int fd, std::string_view data) {
+  while (!data.empty()) {
+    ssize_t written = send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data.remove_prefix(written);
+  }
+  return true;
+}
+
+/// \brief Reads the connections on one thread and runs only complete
+/// request lines on the pool, so an idle client holds no worker.
+///
+/// A connection has at most one request running, later lines wait in its
+/// buffer, so responses come back in request order. Requests beyond the
+/// running and queued ones are answered with "Server busy".
+class Dispatcher {
+ public:
+  Dispatcher(ThreadPool& pool,
+             SetCache& cache,
+             ThreadBudget& thread_budget,
+             size_t max_in_flight)
+      : pool_(pool),
+        cache_(cache),
+        thread_budget_(thread_budget),
+        max_in_flight_(max_in_flight) {
+    if (pipe(wake_) < 0) {
+      throw std::runtime_error("Could not create pipe: " +
+                               std::string(std::strerror(errno)));
+    }
+    fcntl(wake_[0], F_SETFL, O_NONBLOCK);
+    fcntl(wake_[1], F_SETFL, O_NONBLOCK);
+  }
+
+  ~Dispatcher() {
+    for (const auto& [fd, connection] : connections_) {
+      close(fd);
+    }
+    close(wake_[0]);
+    close(wake_[1]);
+  }
+
+  Dispatcher(const Dispatcher&) = delete;
+  Dispatcher& operator=(const Dispatcher&) = delete;
+
+  /// \brief Serves until `stop` is set. Requests still running are left
+  /// to the pool, the caller waits for it before destroying the dispatcher.
+  void run(int listener, const std::atomic<bool>& stop) {
+    std::vector<pollfd> fds;
+    while (!stop) {
+      fds.clear();
+      fds.push_back({wake_[0], POLLIN, 0});
+      fds.push_back({listener, POLLIN, 0});
+      for (const auto& [fd, connection] : connections_) {
+        if (!connection.busy && !connection.closed) {
+          fds.push_back({fd, POLLIN, 0});
+        }
+      }
+
+      // The timeout bounds how long a stop signal that arrives just
+      // before poll() goes unnoticed.
+      if (poll(fds.data(), fds.size(), 500) <= 0) {
+        continue;
+      }
+
+      if (fds[0].revents & POLLIN) {
+        finish_requests();
+      }
+      if (fds[1].revents & POLLIN) {
+        accept_connection(listener);
+      }
+      for (size_t i = 2; i < fds.size(); ++i) {
+        if (fds[i].revents != 0) {
+          read_connection(fds[i].fd);
+        }
+      }
+    }
+  }
+
+ private:
+  /// Longest request line accepted, longer ones close the connection.
+  static constexpr size_t MAX_LINE = 64 * 1024;
+  /// Sends to a client that stopped reading give up after this long.
+  static constexpr int SEND_TIMEOUT_SECONDS = 10;
+
+  struct Connection {
+    std::string buffer;
+    bool busy = false;    // a request of this connection is running
+    bool closed = false;  // the peer hung up, close once it is idle
+  };
+
+  void accept_connection(int listener) {
+    int fd = accept(listener, nullptr, nullptr);
+    if (fd < 0) {
+      return;
+    }
+
+    timeval timeout{.tv_sec = SEND_TIMEOUT_SECONDS, .tv_usec = 0};
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    connections_[fd] = Connection{};
+  }
+
+  void read_connection(int fd) {
+    auto& connection = connections_[fd];
+
+    char chunk[4096];
+    ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+    if (received < 0 && errno == EINTR) {
+      return;
+    }
+    if (received <= 0) {
+      connection.closed = true;
+    } else {
+      connection.buffer.append(chunk, received);
+      if (connection.buffer.size() > MAX_LINE &&
+          connection.buffer.find('\n') == std::string::npos) {
+        write_all(fd, error_json("Request line too long"));
+        connection.closed = true;
+      }
+    }
+
+    dispatch(fd);
+  }
+
+  /// Starts the next buffered request of an idle connection, or closes it
+  /// when the peer hung up.
+  void dispatch(int fd) {
+    auto& connection = connections_[fd];
+
+    size_t newline;
+    while (!connection.busy && !connection.closed &&
+           (newline = connection.buffer.find('\n')) != std::string::npos) {
+      std::string line = connection.buffer.substr(0, newline);
+      connection.buffer.erase(0, newline + 1);
+
+      if (line.find_first_not_of(" \t\r") == std::string::npos) {
+        continue;
+      }
+
+      if (in_flight_ >= max_in_flight_) {
+        if (!write_all(fd, error_json("Server busy"))) {
+          connection.closed = true;
+        }
+        continue;
+      }
+
+      connection.busy = true;
+      ++in_flight_;
+      pool_.submit([this, fd, line = std::move(line)] {
+        std::string response;
+        try {
+          response = handle_request(line, cache_, thread_budget_);
+        } catch (const std::exception& e) {
+          response = error_json(e.what());
+        }
+        write_all(fd, response);
+
+        {
+          std::lock_guard lock(finished_mutex_);
+          finished_.push_back(fd);
+        }
+        char byte = 0;
+        [[maybe_unused]] auto written = write(wake_[1], &byte, 1);
+      });
+    }
+
+    if (!connection.busy && connection.closed) {
+      close(fd);
+      connections_.erase(fd);
+    }
+  }
+
+  void finish_requests() {
+    char drain[256];
+    while (read(wake_[0], drain, sizeof(drain)) > 0) {
+    }
+
+    std::vector<int> finished;
+    {
+      std::lock_guard lock(finished_mutex_);
+      finished.swap(finished_);
+    }
+
+    for (int fd : finished) {
+      --in_flight_;
+      connections_[fd].busy = false;
+      dispatch(fd);
+    }
+  }
+
+  ThreadPool& pool_;
+  SetCache& cache_;
+  ThreadBudget& thread_budget_;
+  size_t max_in_flight_;
+  size_t in_flight_ = 0;  // only touched by the dispatching thread
+
+  std::unordered_map<int, Connection> connections_;
+  int wake_[2];
+  std::mutex finished_mutex_;
+  std::vector<int> finished_;
+};
+
+std::atomic<bool> stop_requested = false;
+
+void on_stop_signal(int) {
+  stop_requested = true;
+}
+
+int main(int argc, char* argv[]) {
+  auto threads_str = take_option(argc, argv, "threads");
+  auto queue_str = take_option(argc, argv, "queue");
+  auto cache_str = take_option(argc, argv, "cache");
+  auto [socket_path] = parse_args<std::string>(
+      argc, argv, "<socket_path> [--threads=N] [--queue=N] [--cache=N]");
+
+  auto thread_count =
+      threads_str ? parse_count(*threads_str, 1)
+                  : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  if (!thread_count.has_value()) {
+    std::print("Invalid thread count: {}\n", *threads_str);
+    return 1;
+  }
+
+  // Requests beyond the running ones and the queue are turned away.
+  auto queue_size = queue_str ? parse_count(*queue_str, 0) : 64;
+  if (!queue_size.has_value()) {
+    std::print("Invalid queue size: {}\n", *queue_str);
+    return 1;
+  }
+
+  auto cache_size = cache_str ? parse_count(*cache_str, 1) : 16;
+  if (!cache_size.has_value()) {
+    std::print("Invalid cache size: {}\n", *cache_str);
+    return 1;
+  }
+
+  int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listener < 0) {
+    std::print("Could not create socket: {}\n", std::strerror(errno));
+    return 1;
+  }
+
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (socket_path.size() >= sizeof(address.sun_path)) {
+    std::print("Socket path too long: {}\n", socket_path);
+    return 1;
+  }
+  std::strcpy(address.sun_path, socket_path.c_str());
+
+  unlink(socket_path.c_str());
+  if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) <
+          0 ||
+      listen(listener, SOMAXCONN) < 0) {
+    std::print("Could not listen on {}: {}\n", socket_path,
+               std::strerror(errno));
+    return 1;
+  }
+
+  // No SA_RESTART, so a stop signal interrupts the blocking poll().
+  struct sigaction action{};
+  action.sa_handler = on_stop_signal;
+  sigaction(SIGINT, &action, nullptr);
+  sigaction(SIGTERM, &action, nullptr);
+
+  SetCache cache(*cache_size);
+  ThreadPool pool(*thread_count);
+  ThreadBudget thread_budget(*thread_count);
+  Dispatcher dispatcher(pool, cache, thread_budget,
+                        *thread_count + *queue_size);
+
+  std::print("Listening on {} with {} threads\n", socket_path,
+             *thread_count);
+
+  dispatcher.run(listener, stop_requested);
+
+  close(listener);
+  unlink(socket_path.c_str());
+  pool.wait();
+}
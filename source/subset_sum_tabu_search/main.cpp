@@ -1,81 +1,60 @@
-#include <algorithm>
-#include <chrono>
-#include <numeric>
+#include <optional>
 #include <print>
-#include <ranges>
 #include <string>
 #include <vector>
 
 #include "helpers.h"
+#include "solvers.h"
 #include "subset_sum.h"
 
-constexpr int MAX_ITERATIONS = 1000;
-
 int main(int argc, char* argv[]) {
+  auto seeding_method_str = take_option(argc, argv, "seeding");
+  auto objective_options = take_objective_options(argc, argv);
+  auto checkpoint_options = take_checkpoint_options(argc, argv);
+  auto telemetry_options = take_telemetry_options(argc, argv);
   auto [set_file, target, max_tabu_size] =
       parse_args<std::string, int, std::optional<int>>(
-          argc, argv, "<file> <target> <max_tabu_size>");
-
-  solve(
-      "Tabu search", set_file, target,
-      [&](const std::vector<int>& set, int target) {
-        std::vector<double> fitness_history;
-
-        std::vector<std::vector<bool>> tabu_mask_list;
-        size_t max_tabu_list_size = 0;
-        bool use_max_tabu_size = false;
-
-        if (max_tabu_size.has_value()) {
-          max_tabu_list_size = max_tabu_size.value();
-          use_max_tabu_size = true;
-        }
-
-        auto best_mask = generate_random_solution_mask(set);
-        auto current_mask = best_mask;
-        auto best_candidate_mask = best_mask;
-
-        tabu_mask_list.push_back(best_mask);
-
-        for (int iteration = 0; iteration < MAX_ITERATIONS; ++iteration) {
-          auto neighbour_masks = generate_near_neighbour_masks(current_mask);
-          int best_neighbour_loss = std::numeric_limits<int>::max();
-
-          for (const auto& neighbour_mask : neighbour_masks) {
-            bool is_in_tabu =
-                std::ranges::contains(tabu_mask_list, neighbour_mask);
-
-            if (!is_in_tabu && loss(get_subset(set, neighbour_mask), target) <
-                                   best_neighbour_loss) {
-              best_candidate_mask = neighbour_mask;
-              best_neighbour_loss =
-                  loss(get_subset(set, neighbour_mask), target);
-            }
-          }
-
-          if (best_neighbour_loss == std::numeric_limits<int>::max()) {
-            break;
-          }
-
-          current_mask = best_candidate_mask;
-          if (best_neighbour_loss < loss(get_subset(set, best_mask), target)) {
-            best_mask = best_candidate_mask;
-          }
-
-          tabu_mask_list.push_back(best_candidate_mask);
-          if (use_max_tabu_size && tabu_mask_list.size() > max_tabu_list_size) {
-            tabu_mask_list.erase(tabu_mask_list.begin());
-          }
-
-          fitness_history.push_back(
-              fitness(get_subset(set, best_mask), target));
-        }
-
-        SubsetSumResult result{
-            .best_subset = get_subset(set, best_mask),
-            .fitness_history = fitness_history,
-            .iterations = MAX_ITERATIONS,
-        };
-
-        return result;
-      });
+          argc, argv,
+          "<file> <target> <max_tabu_size> "
+          "[--seeding=random/greedy/grasp/ratio] "
+          "[--objective=absolute/under_target/cardinality] [--cardinality=k] "
+          "[--checkpoint=path] [--checkpoint-interval=N] [--resume] "
+          "[--telemetry[=stderr/path]] [--telemetry-interval=ms]");
+
+  auto seeding_method =
+      parse_seeding_method(seeding_method_str.value_or("random"));
+  if (!seeding_method.has_value()) {
+    std::print("Invalid seeding method: {}\n", *seeding_method_str);
+    return 1;
+  }
+
+  if (!objective_options.has_value()) {
+    std::print("Invalid objective\n");
+    return 1;
+  }
+
+  if (!checkpoint_options.has_value()) {
+    std::print("Invalid checkpoint options\n");
+    return 1;
+  }
+
+  if (!telemetry_options.has_value()) {
+    std::print("Invalid telemetry options\n");
+    return 1;
+  }
+
+  TabuSearchOptions options{
+      .seeding_method = *seeding_method,
+      .checkpoint = *checkpoint_options,
+      .telemetry = *telemetry_options,
+  };
+  if (max_tabu_size.has_value()) {
+    options.max_tabu_size = max_tabu_size.value();
+  }
+
+  solve("Tabu search", set_file, target, *objective_options,
+        [&](const std::vector<int>& set, int target,
+            const Objective& objective) {
+          return tabu_search(set, target, objective, options);
+        });
 }